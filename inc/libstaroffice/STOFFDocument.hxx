@@ -25,6 +25,8 @@
 #ifndef STOFFDOCUMENT_HXX
 #define STOFFDOCUMENT_HXX
 
+#include <memory>
+
 #ifdef _WINDLL
 #ifdef BUILD_STOFF
 #define STOFFLIB __declspec(dllexport)
@@ -44,11 +46,33 @@ namespace librevenge
 class RVNGBinaryData;
 class RVNGDrawingInterface;
 class RVNGPresentationInterface;
+class RVNGPropertyList;
+class RVNGPropertyListVector;
+class RVNGString;
 class RVNGSpreadsheetInterface;
 class RVNGTextInterface;
 class RVNGInputStream;
 }
 
+/**
+This abstract class defines the callbacks used by STOFFDocument::extractText to
+retrieve the text of a document.
+*/
+class STOFFTextExtractorInterface
+{
+public:
+  //! destructor
+  virtual ~STOFFTextExtractorInterface() {}
+  /** called to insert a run of text.
+      \param text the text encoded in UTF-8 (not null terminated)
+      \param length the number of bytes of text */
+  virtual void insertText(char const *text, unsigned long length) = 0;
+  /** called at the end of a paragraph, a cell, a note, a shape's text, ... */
+  virtual void insertBreak() = 0;
+};
+
+class STOFFParseHandle;
+
 /**
 This class provides all the functions an application would need to parse StarOffice documents.
 */
@@ -82,7 +106,19 @@ public:
     STOFF_R_OLE_ERROR /** problem when reading the OLE structure*/,
     STOFF_R_PARSE_ERROR /** problem when parsing the file*/,
     STOFF_R_PASSWORD_MISSMATCH_ERROR /** problem when using the given password*/,
-    STOFF_R_UNKNOWN_ERROR /** unknown error*/
+    STOFF_R_UNKNOWN_ERROR /** unknown error*/,
+    STOFF_R_CANCELLED /** the parsing has been cancelled, see STOFFParseHandle::cancel */
+  };
+  /** an enum which defines the options which can be passed to the parse functions */
+  enum ParseOption {
+    STOFF_O_NONE=0 /**< no option*/,
+    STOFF_O_SKIP_BINARY_DATA=1 /** do not decode/copy the pictures, the OLE replacement graphics, ...:
+                                   only their type is retrieved */,
+    STOFF_O_RECORD_EMBEDDED_OBJECTS=2 /** the property list of each object sent with a "image/stoff-odg" or
+                                          "image/stoff-ods" binary data also contains the list of calls stored
+                                          in this data in "librevenge:stoff-calls": this list can be sent directly
+                                          to an interface with decodeGraphic(calls,...) or decodeSpreadsheet(calls,...)
+                                          instead of decoding the binary data */
   };
 
   /** Analyzes the content of an input stream to see if it can be parsed
@@ -105,6 +141,13 @@ public:
 
    \note Reserved for future use. Actually, it only returns false */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content using some options (see ParseOption). It will make callbacks to the functions provided by a
+     librevenge::RVNGTextInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGTextInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password, unsigned options);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGDrawingInterface class implementation when needed. This is often commonly called the
@@ -115,6 +158,26 @@ public:
 
      \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content using some options (see ParseOption). It will make callbacks to the functions provided by a
+     librevenge::RVNGDrawingInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGDrawingInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password, unsigned options);
+  /** Parses the input stream content using some options (see ParseOption) and only sends the pages
+     between firstPage and lastPage. It will make callbacks to the functions provided by a
+     librevenge::RVNGDrawingInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGDrawingInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA
+     \param firstPage the first page to send (1 for the first page)
+     \param lastPage the last page to send (included) or -1 to send all the following pages
+
+     \note the master pages which are not used by the sent pages are not sent
+     \note if firstPage is greater than the number of pages, nothing is sent and STOFF_R_PARSE_ERROR is returned */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password, unsigned options, int firstPage, int lastPage);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGPresentationInterface class implementation when needed. This is often commonly called the
@@ -125,6 +188,26 @@ public:
 
      \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content using some options (see ParseOption). It will make callbacks to the functions provided by a
+     librevenge::RVNGPresentationInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGPresentationInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password, unsigned options);
+  /** Parses the input stream content using some options (see ParseOption) and only sends the pages
+     between firstPage and lastPage. It will make callbacks to the functions provided by a
+     librevenge::RVNGPresentationInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGPresentationInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA
+     \param firstPage the first page to send (1 for the first page)
+     \param lastPage the last page to send (included) or -1 to send all the following pages
+
+     \note the master pages which are not used by the sent pages are not sent
+     \note if firstPage is greater than the number of pages, nothing is sent and STOFF_R_PARSE_ERROR is returned */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password, unsigned options, int firstPage, int lastPage);
 
   /** Parses the input stream content. It will make callbacks to the functions provided by a
      librevenge::RVNGSpreadsheetInterface class implementation when needed. This is often commonly called the
@@ -135,6 +218,88 @@ public:
 
    \note Can only convert some basic documents: retrieving more cells' contents but no formating. */
   static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=nullptr);
+  /** Parses the input stream content using some options (see ParseOption). It will make callbacks to the functions provided by a
+     librevenge::RVNGSpreadsheetInterface class implementation when needed.
+     \param input The input stream
+     \param documentInterface A RVNGSpreadsheetInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password, unsigned options);
+  /** Parses the input stream content using some options (see ParseOption) and only sends the
+     cells of a sheet which are in a rectangular window, for instance to create a preview. It will
+     make callbacks to the functions provided by a librevenge::RVNGSpreadsheetInterface class
+     implementation when needed: one sheet is opened and only the rows and the cells (values,
+     formats, merged cells) of the window are sent; each cell keeps its position in
+     librevenge:column and librevenge:row.
+     \param input The input stream
+     \param documentInterface A RVNGSpreadsheetInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption, for instance STOFF_O_SKIP_BINARY_DATA
+     \param sheet the sheet to send (0 for the first sheet)
+     \param firstColumn the first column of the window (0 for the first column)
+     \param firstRow the first row of the window (0 for the first row)
+     \param lastColumn the last column of the window (included)
+     \param lastRow the last row of the window (included)
+
+     \note the cells which are after the last row of the window, or not in its columns, are not
+     decoded (excepted the attributes of the columns on its left) and the other sheets are only read
+     to retrieve their names (used by the formulas). The other parts of the document (styles,
+     shapes, ...) are still parsed.
+     \note the shapes of the sheet are not sent. A merged cell which begins on the left of or above
+     the window is sent clipped to the window; if it begins on the left of the window, its content
+     is not sent. */
+  static STOFFLIB Result parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password, unsigned options,
+                               int sheet, int firstColumn, int firstRow, int lastColumn, int lastRow);
+
+  /** Retrieves the text of a text, spreadsheet, draw or presentation document in reading
+     order and sends it to the extractor. No style, page span, list, ... is created, the
+     pictures are not decoded, so this is faster than calling parse with a
+     librevenge::RVNGTextTextGenerator.
+     \param input The input stream
+     \param extractor A STOFFTextExtractorInterface implementation
+     \param password The file password
+
+     \note the writer's frames, the fields and the spreadsheet's numeric cells are ignored */
+  static STOFFLIB Result extractText(librevenge::RVNGInputStream *input, STOFFTextExtractorInterface *extractor, char const *password=nullptr);
+
+  /** Retrieves the document meta data: title, author, keywords, creation and modification dates, ...
+     Only the OLE directory and the document information zone are read, so this is much faster
+     than calling parse.
+     \param input The input stream
+     \param metaData the property list which is filled with the meta data (using the names
+     sent by parse to librevenge::RVNGXXXInterface::setDocumentMetaData)
+
+     \note the document information zone is not encrypted, so no password is needed */
+  static STOFFLIB Result getMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData);
+  /** Retrieves the document thumbnail: the picture stored by StarOffice as document preview.
+     Only the OLE directory and the preview zone are read, so this is much faster than calling parse.
+     \param input The input stream
+     \param data the picture data
+     \param mimeType the picture mime type (actually "image/ppm")
+
+     \note returns STOFF_R_PARSE_ERROR if the document has no preview or if the preview does not contain a bitmap */
+  static STOFFLIB Result getThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData &data, librevenge::RVNGString &mimeType);
+
+  // ------------------------------------------------------------
+  // the asynchronous parsers
+  // ------------------------------------------------------------
+
+  /** Starts to parse the input stream content in a new thread and returns a handle which can be used
+     to retrieve the progress, to cancel the parsing and to wait for its result.
+     \param input The input stream
+     \param documentInterface A RVNGTextInterface implementation
+     \param password The file password
+     \param options a combination of ParseOption
+
+     \note the documentInterface's functions are called by the parsing thread, input, documentInterface
+     and password must remain valid until the parsing is finished, i.e. until wait returns or the handle is destroyed. */
+  static STOFFLIB std::shared_ptr<STOFFParseHandle> parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password=nullptr, unsigned options=STOFF_O_NONE);
+  /** Starts to parse the input stream content in a new thread, see parseAsync(librevenge::RVNGInputStream *, librevenge::RVNGTextInterface *, char const *, unsigned) */
+  static STOFFLIB std::shared_ptr<STOFFParseHandle> parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password=nullptr, unsigned options=STOFF_O_NONE);
+  /** Starts to parse the input stream content in a new thread, see parseAsync(librevenge::RVNGInputStream *, librevenge::RVNGTextInterface *, char const *, unsigned) */
+  static STOFFLIB std::shared_ptr<STOFFParseHandle> parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password=nullptr, unsigned options=STOFF_O_NONE);
+  /** Starts to parse the input stream content in a new thread, see parseAsync(librevenge::RVNGInputStream *, librevenge::RVNGTextInterface *, char const *, unsigned) */
+  static STOFFLIB std::shared_ptr<STOFFParseHandle> parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password=nullptr, unsigned options=STOFF_O_NONE);
 
   // ------------------------------------------------------------
   // decoders of the embedded zones created by libstoff
@@ -150,6 +315,12 @@ public:
 
    \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB bool decodeGraphic(librevenge::RVNGBinaryData const &binary, librevenge::RVNGDrawingInterface *documentInterface);
+  /** Sends the graphic's calls stored in the "librevenge:stoff-calls" property of an embedded object
+    to documentInterface, see STOFF_O_RECORD_EMBEDDED_OBJECTS.
+
+   \param calls the vector stored in the embedded object property list with key "librevenge:stoff-calls" (and mimeType="image/stoff-odg"),
+   \param documentInterface the RVNGDrawingInterface which will convert the graphic is some specific format. */
+  static STOFFLIB bool decodeGraphic(librevenge::RVNGPropertyListVector const &calls, librevenge::RVNGDrawingInterface *documentInterface);
 
   /** Parses the spreadsheet contained in the binary data and called documentInterface to reconstruct
     a spreadsheet. The input is normally send to a librevenge::RVNGXXXInterface with mimeType="image/stoff-ods",
@@ -161,6 +332,12 @@ public:
 
    \note Reserved for future use. Actually, it only returns false. */
   static STOFFLIB bool decodeSpreadsheet(librevenge::RVNGBinaryData const &binary, librevenge::RVNGSpreadsheetInterface *documentInterface);
+  /** Sends the spreadsheet's calls stored in the "librevenge:stoff-calls" property of an embedded object
+    to documentInterface, see STOFF_O_RECORD_EMBEDDED_OBJECTS.
+
+   \param calls the vector stored in the embedded object property list with key "librevenge:stoff-calls" (and mimeType="image/stoff-ods"),
+   \param documentInterface the RVNGSpreadsheetInterface which will convert the spreadsheet is some specific format. */
+  static STOFFLIB bool decodeSpreadsheet(librevenge::RVNGPropertyListVector const &calls, librevenge::RVNGSpreadsheetInterface *documentInterface);
 
   /** Parses the text contained in the binary data and called documentInterface to reconstruct
     a text. The input is normally send to a librevenge::RVNGXXXInterface with mimeType="image/stoff-odt",
@@ -174,5 +351,36 @@ public:
   static STOFFLIB bool decodeText(librevenge::RVNGBinaryData const &binary, librevenge::RVNGTextInterface *documentInterface);
 };
 
+/**
+This class is returned by STOFFDocument::parseAsync to follow an asynchronous parsing.
+*/
+class STOFFParseHandle
+{
+public:
+  //! the internal data
+  struct Data;
+  //! constructor, called by STOFFDocument::parseAsync
+  explicit STOFFParseHandle(std::shared_ptr<Data> const &data);
+  /** destructor: cancels the parsing if it is not finished and waits for its end */
+  STOFFLIB ~STOFFParseHandle();
+  /** asks to stop the parsing. The parsing stops at the next record or the next page;
+      then wait returns STOFFDocument::STOFF_R_CANCELLED */
+  STOFFLIB void cancel();
+  //! returns true if the parsing is finished
+  STOFFLIB bool isFinished() const;
+  //! waits for the end of the parsing and returns its result
+  STOFFLIB STOFFDocument::Result wait();
+  /** returns the current progress:
+     \param numBytesRead the number of bytes decoded (approximated for the structured files)
+     \param numBytesTotal the size of the main input stream
+     \param numPagesSent the number of pages (or sheets) already sent to the interface */
+  STOFFLIB void getProgress(long &numBytesRead, long &numBytesTotal, int &numPagesSent) const;
+private:
+  STOFFParseHandle(STOFFParseHandle const &orig) = delete;
+  STOFFParseHandle &operator=(STOFFParseHandle const &orig) = delete;
+  //! the internal data
+  std::shared_ptr<Data> m_data;
+};
+
 #endif /* STOFFDOCUMENT_HXX */
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -36,11 +36,20 @@
 #include <unistd.h>
 
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
@@ -69,6 +78,9 @@ static int printUsage()
   printf("\t-o OUTPUT          write ouput to OUTPUT\n");
   printf("\t-N                 Output the number of sheets\n");
   printf("\t-n NUM             choose the page to convert (1: means first page)\n");
+  printf("\t-a                 convert all the pages, the page N is written in OUTPUT-N.svg\n");
+  printf("\t                   as soon as it is created (needs -o)\n");
+  printf("\t-j NUM             with -a, use NUM threads to write the pages\n");
   printf("\t-v                 show version information\n");
   printf("\n");
   printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
@@ -81,6 +93,288 @@ static int printVersion()
   return 0;
 }
 
+static void writeSVG(std::ostream &out, char const *content)
+{
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
+  out << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
+  out << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
+  out << content << std::endl;
+}
+
+//! class used to write each page in its own file: OUTPUT-N.svg, in the caller thread or in some writer threads
+class SVGPageWriter
+{
+public:
+  //! constructor
+  SVGPageWriter(std::string const &prefix, int numThreads)
+    : m_prefix(prefix)
+    , m_numPages(0)
+    , m_numErrors(0)
+    , m_mutex()
+    , m_errorMutex()
+    , m_condition()
+    , m_spaceCondition()
+    , m_pageList()
+    , m_finished(false)
+    , m_threadList()
+  {
+    try {
+      for (int i=0; i<numThreads; ++i)
+        m_threadList.push_back(std::thread(&SVGPageWriter::run, this));
+    }
+    catch (std::system_error const &) {
+      // if no thread can be created, the pages are written by the calling thread
+      fprintf(stderr, "WARNING: can only create %d writer threads!\n", int(m_threadList.size()));
+    }
+  }
+  //! destructor
+  ~SVGPageWriter()
+  {
+    finish();
+  }
+  //! adds a new page, waits if too many pages are waiting to be written
+  void addPage(std::string &&content)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    int page=++m_numPages;
+    if (m_threadList.empty()) {
+      lock.unlock();
+      write(page, content);
+      return;
+    }
+    size_t const maxPages=2*m_threadList.size();
+    m_spaceCondition.wait(lock, [this, maxPages] { return m_pageList.size()<maxPages; });
+    m_pageList.push_back(std::make_pair(page, std::move(content)));
+    m_condition.notify_one();
+  }
+  //! waits for all the pages to be written
+  void finish()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_finished=true;
+    }
+    m_condition.notify_all();
+    for (auto &thread : m_threadList)
+      thread.join();
+    m_threadList.clear();
+  }
+  //! returns the number of pages
+  int getNumPages() const
+  {
+    return m_numPages;
+  }
+  //! returns the number of pages which can not be written
+  int getNumErrors() const
+  {
+    return m_numErrors;
+  }
+protected:
+  //! the writer thread function
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_condition.wait(lock, [this] { return m_finished || !m_pageList.empty(); });
+      if (m_pageList.empty())
+        return;
+      auto page=std::move(m_pageList.front());
+      m_pageList.pop_front();
+      lock.unlock();
+      m_spaceCondition.notify_one();
+      write(page.first, page.second);
+      lock.lock();
+    }
+  }
+  //! writes a page
+  void write(int page, std::string const &content)
+  {
+    std::ofstream out(m_prefix+"-"+std::to_string(page)+".svg");
+    if (out.is_open())
+      writeSVG(out, content.c_str());
+    if (!out.is_open() || !out.good()) {
+      std::lock_guard<std::mutex> lock(m_errorMutex);
+      fprintf(stderr, "ERROR: can not write page %d!\n", page);
+      ++m_numErrors;
+    }
+  }
+
+  //! the output prefix
+  std::string m_prefix;
+  //! the number of pages
+  int m_numPages;
+  //! the number of pages which can not be written
+  int m_numErrors;
+  //! the mutex used to protect the page list
+  std::mutex m_mutex;
+  //! the mutex used to protect the errors
+  std::mutex m_errorMutex;
+  //! the condition used to wake up the writer threads
+  std::condition_variable m_condition;
+  //! the condition used to wake up addPage when a page is removed from the list
+  std::condition_variable m_spaceCondition;
+  //! the list of pages to write: page number, content
+  std::deque<std::pair<int, std::string> > m_pageList;
+  //! a flag to know if all pages are added
+  bool m_finished;
+  //! the writer threads
+  std::vector<std::thread> m_threadList;
+private:
+  SVGPageWriter(SVGPageWriter const &) = delete;
+  SVGPageWriter &operator=(SVGPageWriter const &) = delete;
+};
+
+#define SD2SVG_FORWARD(name) \
+  void name(const librevenge::RVNGPropertyList &propList) override \
+  { \
+    m_generator.name(propList); \
+  }
+#define SD2SVG_FORWARD0(name) \
+  void name() override \
+  { \
+    m_generator.name(); \
+  }
+#define SD2SVG_FORWARD_COMMON \
+  SD2SVG_FORWARD(setDocumentMetaData) \
+  SD2SVG_FORWARD(defineEmbeddedFont) \
+  SD2SVG_FORWARD(setStyle) \
+  SD2SVG_FORWARD(startLayer) \
+  SD2SVG_FORWARD0(endLayer) \
+  SD2SVG_FORWARD(startEmbeddedGraphics) \
+  SD2SVG_FORWARD0(endEmbeddedGraphics) \
+  SD2SVG_FORWARD(openGroup) \
+  SD2SVG_FORWARD0(closeGroup) \
+  SD2SVG_FORWARD(drawRectangle) \
+  SD2SVG_FORWARD(drawEllipse) \
+  SD2SVG_FORWARD(drawPolygon) \
+  SD2SVG_FORWARD(drawPolyline) \
+  SD2SVG_FORWARD(drawPath) \
+  SD2SVG_FORWARD(drawGraphicObject) \
+  SD2SVG_FORWARD(drawConnector) \
+  SD2SVG_FORWARD(startTextObject) \
+  SD2SVG_FORWARD0(endTextObject) \
+  SD2SVG_FORWARD(startTableObject) \
+  SD2SVG_FORWARD(openTableRow) \
+  SD2SVG_FORWARD0(closeTableRow) \
+  SD2SVG_FORWARD(openTableCell) \
+  SD2SVG_FORWARD0(closeTableCell) \
+  SD2SVG_FORWARD(insertCoveredTableCell) \
+  SD2SVG_FORWARD0(endTableObject) \
+  SD2SVG_FORWARD0(insertTab) \
+  SD2SVG_FORWARD0(insertSpace) \
+  void insertText(const librevenge::RVNGString &text) override \
+  { \
+    m_generator.insertText(text); \
+  } \
+  SD2SVG_FORWARD0(insertLineBreak) \
+  SD2SVG_FORWARD(insertField) \
+  SD2SVG_FORWARD(openLink) \
+  SD2SVG_FORWARD0(closeLink) \
+  SD2SVG_FORWARD(openOrderedListLevel) \
+  SD2SVG_FORWARD(openUnorderedListLevel) \
+  SD2SVG_FORWARD0(closeOrderedListLevel) \
+  SD2SVG_FORWARD0(closeUnorderedListLevel) \
+  SD2SVG_FORWARD(openListElement) \
+  SD2SVG_FORWARD0(closeListElement) \
+  SD2SVG_FORWARD(defineParagraphStyle) \
+  SD2SVG_FORWARD(openParagraph) \
+  SD2SVG_FORWARD0(closeParagraph) \
+  SD2SVG_FORWARD(defineCharacterStyle) \
+  SD2SVG_FORWARD(openSpan) \
+  SD2SVG_FORWARD0(closeSpan)
+
+//! a SVG drawing generator which sends each page to a SVGPageWriter as soon as the page is created
+class SVGStreamDrawingGenerator final : public librevenge::RVNGDrawingInterface
+{
+public:
+  //! constructor
+  explicit SVGStreamDrawingGenerator(SVGPageWriter &writer)
+    : m_writer(writer)
+    , m_pages()
+    , m_generator(m_pages, "")
+  {
+  }
+  SD2SVG_FORWARD(startDocument)
+  SD2SVG_FORWARD0(endDocument)
+  SD2SVG_FORWARD(startPage)
+  void endPage() override
+  {
+    m_generator.endPage();
+    for (unsigned i=0; i<m_pages.size(); ++i)
+      m_writer.addPage(std::string(m_pages[i].cstr()));
+    m_pages.clear();
+  }
+  SD2SVG_FORWARD(startMasterPage)
+  SD2SVG_FORWARD0(endMasterPage)
+  SD2SVG_FORWARD_COMMON
+protected:
+  //! the page writer
+  SVGPageWriter &m_writer;
+  //! the pages created by the generator
+  librevenge::RVNGStringVector m_pages;
+  //! the svg generator
+  librevenge::RVNGSVGDrawingGenerator m_generator;
+};
+
+//! a SVG presentation generator which sends each slide to a SVGPageWriter as soon as the slide is created
+class SVGStreamPresentationGenerator final : public librevenge::RVNGPresentationInterface
+{
+public:
+  //! constructor
+  explicit SVGStreamPresentationGenerator(SVGPageWriter &writer)
+    : m_writer(writer)
+    , m_pages()
+    , m_generator(m_pages)
+  {
+  }
+  SD2SVG_FORWARD(startDocument)
+  SD2SVG_FORWARD0(endDocument)
+  SD2SVG_FORWARD(startSlide)
+  void endSlide() override
+  {
+    m_generator.endSlide();
+    for (unsigned i=0; i<m_pages.size(); ++i)
+      m_writer.addPage(std::string(m_pages[i].cstr()));
+    m_pages.clear();
+  }
+  SD2SVG_FORWARD(startMasterSlide)
+  SD2SVG_FORWARD0(endMasterSlide)
+  SD2SVG_FORWARD(setSlideTransition)
+  SD2SVG_FORWARD_COMMON
+  SD2SVG_FORWARD(startComment)
+  SD2SVG_FORWARD0(endComment)
+  SD2SVG_FORWARD(startNotes)
+  SD2SVG_FORWARD0(endNotes)
+  SD2SVG_FORWARD(defineChartStyle)
+  SD2SVG_FORWARD(openChart)
+  SD2SVG_FORWARD0(closeChart)
+  SD2SVG_FORWARD(openChartTextObject)
+  SD2SVG_FORWARD0(closeChartTextObject)
+  SD2SVG_FORWARD(openChartPlotArea)
+  SD2SVG_FORWARD0(closeChartPlotArea)
+  SD2SVG_FORWARD(insertChartAxis)
+  SD2SVG_FORWARD(openChartSeries)
+  SD2SVG_FORWARD0(closeChartSeries)
+  SD2SVG_FORWARD(openAnimationSequence)
+  SD2SVG_FORWARD0(closeAnimationSequence)
+  SD2SVG_FORWARD(openAnimationGroup)
+  SD2SVG_FORWARD0(closeAnimationGroup)
+  SD2SVG_FORWARD(openAnimationIteration)
+  SD2SVG_FORWARD0(closeAnimationIteration)
+  SD2SVG_FORWARD(insertAnimation)
+protected:
+  //! the page writer
+  SVGPageWriter &m_writer;
+  //! the pages created by the generator
+  librevenge::RVNGStringVector m_pages;
+  //! the svg generator
+  librevenge::RVNGSVGPresentationGenerator m_generator;
+};
+
+#undef SD2SVG_FORWARD_COMMON
+#undef SD2SVG_FORWARD0
+#undef SD2SVG_FORWARD
+
 int main(int argc, char *argv[])
 {
   if (argc < 2)
@@ -89,9 +383,10 @@ int main(int argc, char *argv[])
   char const *output = nullptr;
   bool printHelp=false;
   bool printNumberOfPages=false;
-  int ch, pageToConvert=0;
+  bool streamPages=false;
+  int ch, pageToConvert=0, numThreads=0;
 
-  while ((ch = getopt(argc, argv, "ho:n:vN")) != -1) {
+  while ((ch = getopt(argc, argv, "aho:j:n:vN")) != -1) {
     switch (ch) {
     case 'o':
       output=optarg;
@@ -105,6 +400,12 @@ int main(int argc, char *argv[])
     case 'N':
       printNumberOfPages=true;
       break;
+    case 'a':
+      streamPages=true;
+      break;
+    case 'j':
+      numThreads=std::atoi(optarg);
+      break;
     default:
     case 'h':
       printHelp = true;
@@ -112,7 +413,7 @@ int main(int argc, char *argv[])
     }
   }
 
-  if (argc != 1+optind || printHelp) {
+  if (argc != 1+optind || printHelp || (streamPages && !output)) {
     printUsage();
     return -1;
   }
@@ -133,12 +434,23 @@ int main(int argc, char *argv[])
   }
   auto error=STOFFDocument::STOFF_R_OK;
   librevenge::RVNGStringVector vec;
+  std::unique_ptr<SVGPageWriter> writer;
+  if (streamPages)
+    writer.reset(new SVGPageWriter(output, numThreads>1 ? numThreads : 0));
 
   try {
-    if (kind == STOFFDocument::STOFF_K_DRAW) {
+    if (kind == STOFFDocument::STOFF_K_DRAW && writer) {
+      SVGStreamDrawingGenerator listener(*writer);
+      error = STOFFDocument::parse(&input, &listener);
+    }
+    else if (kind == STOFFDocument::STOFF_K_DRAW) {
       librevenge::RVNGSVGDrawingGenerator listener(vec, "");
       error = STOFFDocument::parse(&input, &listener);
     }
+    else if (kind == STOFFDocument::STOFF_K_PRESENTATION && writer) {
+      SVGStreamPresentationGenerator listener(*writer);
+      error = STOFFDocument::parse(&input, &listener);
+    }
     else if (kind == STOFFDocument::STOFF_K_PRESENTATION) {
       librevenge::RVNGSVGPresentationGenerator listener(vec);
       error = STOFFDocument::parse(&input, &listener);
@@ -147,7 +459,12 @@ int main(int argc, char *argv[])
       fprintf(stderr,"ERROR: not a graphic/presentation document!\n");
       return 1;
     }
-    if (error==STOFFDocument::STOFF_R_OK && (vec.empty() || vec[0].empty()))
+    if (writer) {
+      writer->finish();
+      if (error==STOFFDocument::STOFF_R_OK && writer->getNumPages()==0)
+        error = STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+    }
+    else if (error==STOFFDocument::STOFF_R_OK && (vec.empty() || vec[0].empty()))
       error = STOFFDocument::STOFF_R_UNKNOWN_ERROR;
   }
   catch (STOFFDocument::Result const &err) {
@@ -168,6 +485,11 @@ int main(int argc, char *argv[])
   if (error != STOFFDocument::STOFF_R_OK)
     return 1;
 
+  if (writer) {
+    if (printNumberOfPages)
+      std::cout << writer->getNumPages() << "\n";
+    return writer->getNumErrors() ? 1 : 0;
+  }
   if (printNumberOfPages) {
     std::cout << vec.size() << "\n";
     return 0;
@@ -178,18 +500,11 @@ int main(int argc, char *argv[])
     fprintf(stderr, "ERROR: can not find page %d!\n", int(page));
     return 1;
   }
-  if (!output) {
-    std::cout << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
-    std::cout << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
-    std::cout << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
-    std::cout << vec[page].cstr() << std::endl;
-  }
+  if (!output)
+    writeSVG(std::cout, vec[page].cstr());
   else {
     std::ofstream out(output);
-    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
-    out << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"";
-    out << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n";
-    out << vec[page].cstr() << std::endl;
+    writeSVG(out, vec[page].cstr());
   }
   return 0;
 }
@@ -34,6 +34,8 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <string>
+
 #include <librevenge/librevenge.h>
 #include <librevenge-generators/librevenge-generators.h>
 #include <librevenge-stream/librevenge-stream.h>
@@ -50,6 +52,29 @@
 
 #define TOOLNAME "sd2text"
 
+//! small class used to store the text retrieved by STOFFDocument::extractText
+class TextExtractor final : public STOFFTextExtractorInterface
+{
+public:
+  //! constructor
+  TextExtractor()
+    : m_text()
+  {
+  }
+  //! adds a text run
+  void insertText(char const *text, unsigned long length) final
+  {
+    m_text.append(text, size_t(length));
+  }
+  //! adds a line break
+  void insertBreak() final
+  {
+    m_text+='\n';
+  }
+  //! the text
+  std::string m_text;
+};
+
 static int printUsage()
 {
   printf("`" TOOLNAME "' converts StarOffice documents to plain text.\n");
@@ -62,6 +87,7 @@ static int printUsage()
   printf("\t-o OUTPUT         write ouput to OUTPUT\n");
   printf("\t-p PASSWORD       set password to open the file\n");
   printf("\t-v                show version information\n");
+  printf("\t-x                only extract the raw text (faster, no layout)\n");
   printf("\n");
   printf("Report bugs to <https://github.com/fosnola/libstaroffice/issues>.\n");
   return 0;
@@ -81,10 +107,11 @@ int main(int argc, char *argv[])
   char const *output = nullptr;
   char const *password=nullptr;
   bool isInfo = false;
+  bool extractOnly = false;
   bool printHelp=false;
   int ch;
 
-  while ((ch = getopt(argc, argv, "hio:p:v")) != -1) {
+  while ((ch = getopt(argc, argv, "hio:p:vx")) != -1) {
     switch (ch) {
     case 'i':
       isInfo=true;
@@ -98,6 +125,9 @@ int main(int argc, char *argv[])
     case 'v':
       printVersion();
       return 0;
+    case 'x':
+      extractOnly=true;
+      break;
     default:
     case 'h':
       printHelp = true;
@@ -130,13 +160,18 @@ int main(int argc, char *argv[])
   bool useStringVector=false;
   auto error = STOFFDocument::STOFF_R_OK;
   try {
-    if (kind == STOFFDocument::STOFF_K_DRAW || kind == STOFFDocument::STOFF_K_GRAPHIC) {
+    if (extractOnly && !isInfo && kind != STOFFDocument::STOFF_K_GRAPHIC && kind != STOFFDocument::STOFF_K_DATABASE) {
+      TextExtractor extractor;
+      error=STOFFDocument::extractText(&input, &extractor, password);
+      document=extractor.m_text.c_str();
+    }
+    else if (kind == STOFFDocument::STOFF_K_DRAW || kind == STOFFDocument::STOFF_K_GRAPHIC) {
       if (isInfo) {
         printf("ERROR: can not print info concerning a graphic document!\n");
         return 1;
       }
       librevenge::RVNGTextDrawingGenerator documentGenerator(pages);
-      error=STOFFDocument::parse(&input, &documentGenerator, password);
+      error=STOFFDocument::parse(&input, &documentGenerator, password, STOFFDocument::STOFF_O_SKIP_BINARY_DATA);
       if (error == STOFFDocument::STOFF_R_OK && !pages.size()) {
         printf("ERROR: find no graphics!\n");
         return 1;
@@ -145,7 +180,7 @@ int main(int argc, char *argv[])
     }
     else if (kind == STOFFDocument::STOFF_K_SPREADSHEET || kind == STOFFDocument::STOFF_K_DATABASE) {
       librevenge::RVNGTextSpreadsheetGenerator documentGenerator(pages, isInfo);
-      error=STOFFDocument::parse(&input, &documentGenerator, password);
+      error=STOFFDocument::parse(&input, &documentGenerator, password, STOFFDocument::STOFF_O_SKIP_BINARY_DATA);
       if (error == STOFFDocument::STOFF_R_OK && !pages.size()) {
         printf("ERROR: find no sheets!\n");
         return 1;
@@ -158,7 +193,7 @@ int main(int argc, char *argv[])
         return 1;
       }
       librevenge::RVNGTextPresentationGenerator documentGenerator(pages);
-      error=STOFFDocument::parse(&input, &documentGenerator, password);
+      error=STOFFDocument::parse(&input, &documentGenerator, password, STOFFDocument::STOFF_O_SKIP_BINARY_DATA);
       if (error == STOFFDocument::STOFF_R_OK && !pages.size()) {
         printf("ERROR: find no slides!\n");
         return 1;
@@ -167,7 +202,7 @@ int main(int argc, char *argv[])
     }
     else {
       librevenge::RVNGTextTextGenerator documentGenerator(document, isInfo);
-      error=STOFFDocument::parse(&input, &documentGenerator, password);
+      error=STOFFDocument::parse(&input, &documentGenerator, password, STOFFDocument::STOFF_O_SKIP_BINARY_DATA);
     }
   }
   catch (STOFFDocument::Result const &err) {
@@ -37,11 +37,12 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <ctime>
 #include <fstream>
 #include <iostream>
+#include <string>
 
 #include <librevenge/librevenge.h>
-#include <librevenge-generators/librevenge-generators.h>
 #include <librevenge-stream/librevenge-stream.h>
 
 #include <libstaroffice/libstaroffice.hxx>
@@ -91,6 +92,441 @@ static int printVersion()
   return 0;
 }
 
+/** a spreadsheet generator which writes a sheet in CSV, each row being
+    written as soon as it is closed.
+
+    \note the repeated rows and cells are written without being stored and the
+    final empty rows and cells are not written */
+class CSVStreamGenerator final : public librevenge::RVNGSpreadsheetInterface
+{
+public:
+  //! constructor: sheet is the sheet to write (0: means first sheet), output can be null
+  CSVStreamGenerator(std::ostream *output, int sheet, bool generateFormula)
+    : m_output(output)
+    , m_sheetToWrite(sheet)
+    , m_generateFormula(generateFormula)
+    , m_fieldSeparator(',')
+    , m_textSeparator('"')
+    , m_decimalSeparator('.')
+    , m_dateFormat("%m/%d/%y")
+    , m_timeFormat("%H:%M:%S")
+    , m_numSheets(0)
+    , m_inSheet(false)
+    , m_row()
+    , m_numRowsRepeated(1)
+    , m_numEmptyRows(0)
+    , m_numFields(0)
+    , m_column(0)
+    , m_numEmptyColumns(0)
+    , m_inCell(false)
+    , m_cell()
+    , m_cellText()
+    , m_cellParagraph(0)
+    , m_auxiliaryDepth(0)
+  {
+  }
+  //! sets the field, the text and the decimal separators
+  void setSeparators(char fieldSeparator, char textSeparator, char decimalSeparator)
+  {
+    m_fieldSeparator=fieldSeparator;
+    m_textSeparator=textSeparator;
+    m_decimalSeparator=decimalSeparator;
+  }
+  //! sets the date and time formats (strftime formats)
+  void setDTFormats(char const *dateFormat, char const *timeFormat)
+  {
+    m_dateFormat=dateFormat ? dateFormat : "";
+    m_timeFormat=timeFormat ? timeFormat : "";
+  }
+  //! returns the number of sheets
+  int getNumSheets() const
+  {
+    return m_numSheets;
+  }
+  //! returns true if the sheet to write exists
+  bool hasFoundSheet() const
+  {
+    return m_numSheets>m_sheetToWrite;
+  }
+
+  void openSheet(const librevenge::RVNGPropertyList &) final
+  {
+    m_inSheet=m_output && m_numSheets==m_sheetToWrite;
+    ++m_numSheets;
+    m_numEmptyRows=0;
+  }
+  void closeSheet() final
+  {
+    // the final empty rows are not written
+    m_inSheet=false;
+    if (m_output) m_output->flush();
+  }
+  void openSheetRow(const librevenge::RVNGPropertyList &propList) final
+  {
+    if (!m_inSheet) return;
+    m_row.clear();
+    m_numFields=m_column=m_numEmptyColumns=0;
+    m_numRowsRepeated=propList["table:number-rows-repeated"] ? propList["table:number-rows-repeated"]->getInt() : 1;
+    if (m_numRowsRepeated<1) m_numRowsRepeated=1;
+  }
+  void closeSheetRow() final
+  {
+    if (!m_inSheet) return;
+    if (m_row.empty()) {
+      m_numEmptyRows+=long(m_numRowsRepeated);
+      return;
+    }
+    for (; m_numEmptyRows>0; --m_numEmptyRows)
+      *m_output << "\n";
+    for (int r=0; r<m_numRowsRepeated; ++r)
+      *m_output << m_row << "\n";
+  }
+  void openSheetCell(const librevenge::RVNGPropertyList &propList) final
+  {
+    if (!m_inSheet) return;
+    m_inCell=true;
+    m_cell=propList;
+    m_cellText.clear();
+    m_cellParagraph=0;
+  }
+  void closeSheetCell() final
+  {
+    if (!m_inSheet || !m_inCell) return;
+    m_inCell=false;
+    int column=m_cell["librevenge:column"] ? m_cell["librevenge:column"]->getInt() : m_column;
+    if (column>m_column) {
+      m_numEmptyColumns+=column-m_column;
+      m_column=column;
+    }
+    int numRepeated=m_cell["table:number-columns-repeated"] ? m_cell["table:number-columns-repeated"]->getInt() : 1;
+    if (numRepeated<1) numRepeated=1;
+    m_column+=numRepeated;
+    std::string field=getCellField();
+    if (field.empty()) {
+      m_numEmptyColumns+=numRepeated;
+      return;
+    }
+    for (; m_numEmptyColumns>0; --m_numEmptyColumns)
+      addField("");
+    for (int c=0; c<numRepeated; ++c)
+      addField(field);
+  }
+
+  void openParagraph(const librevenge::RVNGPropertyList &) final
+  {
+    if (m_inCell && !m_auxiliaryDepth && m_cellParagraph++)
+      m_cellText+='\n';
+  }
+  void closeParagraph() final {}
+  void insertTab() final
+  {
+    if (isInCellText()) m_cellText+='\t';
+  }
+  void insertSpace() final
+  {
+    if (isInCellText()) m_cellText+=' ';
+  }
+  void insertText(const librevenge::RVNGString &text) final
+  {
+    if (isInCellText()) m_cellText+=text.cstr();
+  }
+  void insertLineBreak() final
+  {
+    if (isInCellText()) m_cellText+='\n';
+  }
+  void insertField(const librevenge::RVNGPropertyList &propList) final
+  {
+    if (isInCellText() && propList["librevenge:field-content"])
+      m_cellText+=propList["librevenge:field-content"]->getStr().cstr();
+  }
+
+  // the zones whose text does not belong to the cell
+  void openFootnote(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_auxiliaryDepth;
+  }
+  void closeFootnote() final
+  {
+    --m_auxiliaryDepth;
+  }
+  void openComment(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_auxiliaryDepth;
+  }
+  void closeComment() final
+  {
+    --m_auxiliaryDepth;
+  }
+  void openFrame(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_auxiliaryDepth;
+  }
+  void closeFrame() final
+  {
+    --m_auxiliaryDepth;
+  }
+  void openChart(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_auxiliaryDepth;
+  }
+  void closeChart() final
+  {
+    --m_auxiliaryDepth;
+  }
+  void openHeader(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_auxiliaryDepth;
+  }
+  void closeHeader() final
+  {
+    --m_auxiliaryDepth;
+  }
+  void openFooter(const librevenge::RVNGPropertyList &) final
+  {
+    ++m_auxiliaryDepth;
+  }
+  void closeFooter() final
+  {
+    --m_auxiliaryDepth;
+  }
+
+  // the ignored functions
+  void setDocumentMetaData(const librevenge::RVNGPropertyList &) final {}
+  void startDocument(const librevenge::RVNGPropertyList &) final {}
+  void endDocument() final {}
+  void definePageStyle(const librevenge::RVNGPropertyList &) final {}
+  void defineEmbeddedFont(const librevenge::RVNGPropertyList &) final {}
+  void openPageSpan(const librevenge::RVNGPropertyList &) final {}
+  void closePageSpan() final {}
+  void defineSheetNumberingStyle(const librevenge::RVNGPropertyList &) final {}
+  void defineChartStyle(const librevenge::RVNGPropertyList &) final {}
+  void openChartTextObject(const librevenge::RVNGPropertyList &) final {}
+  void closeChartTextObject() final {}
+  void openChartPlotArea(const librevenge::RVNGPropertyList &) final {}
+  void closeChartPlotArea() final {}
+  void insertChartAxis(const librevenge::RVNGPropertyList &) final {}
+  void openChartSerie(const librevenge::RVNGPropertyList &) final {}
+  void closeChartSerie() final {}
+  void defineParagraphStyle(const librevenge::RVNGPropertyList &) final {}
+  void defineCharacterStyle(const librevenge::RVNGPropertyList &) final {}
+  void openSpan(const librevenge::RVNGPropertyList &) final {}
+  void closeSpan() final {}
+  void openLink(const librevenge::RVNGPropertyList &) final {}
+  void closeLink() final {}
+  void defineSectionStyle(const librevenge::RVNGPropertyList &) final {}
+  void openSection(const librevenge::RVNGPropertyList &) final {}
+  void closeSection() final {}
+  void openOrderedListLevel(const librevenge::RVNGPropertyList &) final {}
+  void openUnorderedListLevel(const librevenge::RVNGPropertyList &) final {}
+  void closeOrderedListLevel() final {}
+  void closeUnorderedListLevel() final {}
+  void openListElement(const librevenge::RVNGPropertyList &) final {}
+  void closeListElement() final {}
+  void insertBinaryObject(const librevenge::RVNGPropertyList &) final {}
+  void openTextBox(const librevenge::RVNGPropertyList &) final {}
+  void closeTextBox() final {}
+  void openTable(const librevenge::RVNGPropertyList &) final {}
+  void closeTable() final {}
+  void openTableRow(const librevenge::RVNGPropertyList &) final {}
+  void closeTableRow() final {}
+  void openTableCell(const librevenge::RVNGPropertyList &) final {}
+  void closeTableCell() final {}
+  void insertCoveredTableCell(const librevenge::RVNGPropertyList &) final {}
+  void openGroup(const librevenge::RVNGPropertyList &) final {}
+  void closeGroup() final {}
+  void defineGraphicStyle(const librevenge::RVNGPropertyList &) final {}
+  void drawRectangle(const librevenge::RVNGPropertyList &) final {}
+  void drawEllipse(const librevenge::RVNGPropertyList &) final {}
+  void drawPolygon(const librevenge::RVNGPropertyList &) final {}
+  void drawPolyline(const librevenge::RVNGPropertyList &) final {}
+  void drawPath(const librevenge::RVNGPropertyList &) final {}
+  void drawConnector(const librevenge::RVNGPropertyList &) final {}
+  void insertEquation(const librevenge::RVNGPropertyList &) final {}
+protected:
+  //! returns true if some text must be added to the cell
+  bool isInCellText() const
+  {
+    return m_inCell && !m_auxiliaryDepth;
+  }
+  //! adds a field to the current row
+  void addField(std::string const &field)
+  {
+    if (m_numFields++)
+      m_row+=m_fieldSeparator;
+    m_row+=field;
+  }
+  //! returns a field corresponding to a text
+  std::string getTextField(std::string const &text) const
+  {
+    std::string res(1, m_textSeparator);
+    for (auto c : text) {
+      if (c==m_textSeparator) res+=c;
+      res+=c;
+    }
+    res+=m_textSeparator;
+    return res;
+  }
+  //! returns a number
+  static std::string getNumber(double value, char decimalSeparator)
+  {
+    char buffer[50];
+    snprintf(buffer, sizeof(buffer), "%.15g", value);
+    std::string res(buffer);
+    if (decimalSeparator!='.') {
+      for (auto &c : res) {
+        if (c=='.') c=decimalSeparator;
+      }
+    }
+    return res;
+  }
+  //! returns a date or a time using format
+  static std::string getDateTime(std::string const &format, struct tm &time)
+  {
+    char buffer[256];
+    if (format.empty() || strftime(buffer, sizeof(buffer), format.c_str(), &time)==0)
+      return "";
+    return buffer;
+  }
+  //! returns the current cell's field
+  std::string getCellField() const
+  {
+    if (m_generateFormula && m_cell["librevenge:formula"] && m_cell.child("librevenge:formula")) {
+      auto formula=getFormula(*m_cell.child("librevenge:formula"));
+      if (!formula.empty())
+        return getTextField(formula);
+    }
+    std::string type=m_cell["librevenge:value-type"] ? m_cell["librevenge:value-type"]->getStr().cstr() : "";
+    if (type=="date" && m_cell["librevenge:year"]) {
+      struct tm time= {};
+      time.tm_year=(m_cell["librevenge:year"]->getInt())-1900;
+      time.tm_mon=(m_cell["librevenge:month"] ? m_cell["librevenge:month"]->getInt() : 1)-1;
+      time.tm_mday=m_cell["librevenge:day"] ? m_cell["librevenge:day"]->getInt() : 1;
+      auto res=getDateTime(m_dateFormat, time);
+      if (m_cell["librevenge:hours"]) {
+        time.tm_hour=m_cell["librevenge:hours"]->getInt();
+        time.tm_min=m_cell["librevenge:minutes"] ? m_cell["librevenge:minutes"]->getInt() : 0;
+        time.tm_sec=m_cell["librevenge:seconds"] ? m_cell["librevenge:seconds"]->getInt() : 0;
+        res+=" "+getDateTime(m_timeFormat, time);
+      }
+      return res;
+    }
+    if (type=="time" && m_cell["librevenge:hours"]) {
+      struct tm time= {};
+      time.tm_hour=m_cell["librevenge:hours"]->getInt();
+      time.tm_min=m_cell["librevenge:minutes"] ? m_cell["librevenge:minutes"]->getInt() : 0;
+      time.tm_sec=m_cell["librevenge:seconds"] ? m_cell["librevenge:seconds"]->getInt() : 0;
+      return getDateTime(m_timeFormat, time);
+    }
+    if (m_cell["librevenge:value"]) {
+      double value=m_cell["librevenge:value"]->getDouble();
+      if (type=="boolean")
+        return (value<0 || value>0) ? "true" : "false";
+      if (type=="percent")
+        return getNumber(100*value, m_decimalSeparator)+"%";
+      return getNumber(value, m_decimalSeparator);
+    }
+    if (!m_cellText.empty())
+      return getTextField(m_cellText);
+    return "";
+  }
+  //! returns the cell name
+  static std::string getCellName(librevenge::RVNGPropertyList const &propList, std::string const &prefix)
+  {
+    std::string res;
+    int column=propList[(prefix+"column").c_str()] ? propList[(prefix+"column").c_str()]->getInt() : 0;
+    int row=propList[(prefix+"row").c_str()] ? propList[(prefix+"row").c_str()]->getInt() : 0;
+    if (column<0 || row<0) return "#REF!";
+    if (propList[(prefix+"column-absolute").c_str()] && propList[(prefix+"column-absolute").c_str()]->getInt())
+      res+='$';
+    std::string colName;
+    for (++column; column>0; column=(column-1)/26)
+      colName.insert(colName.begin(), char('A'+(column-1)%26));
+    res+=colName;
+    if (propList[(prefix+"row-absolute").c_str()] && propList[(prefix+"row-absolute").c_str()]->getInt())
+      res+='$';
+    res+=std::to_string(row+1);
+    return res;
+  }
+  //! returns a formula
+  static std::string getFormula(librevenge::RVNGPropertyListVector const &formula)
+  {
+    std::string res("=");
+    for (unsigned long i=0; i<formula.count(); ++i) {
+      auto const &instr=formula[i];
+      if (!instr["librevenge:type"]) return "";
+      std::string type=instr["librevenge:type"]->getStr().cstr();
+      if (type=="librevenge-operator" && instr["librevenge:operator"])
+        res+=instr["librevenge:operator"]->getStr().cstr();
+      else if (type=="librevenge-function" && instr["librevenge:function"])
+        res+=instr["librevenge:function"]->getStr().cstr();
+      else if (type=="librevenge-number" && instr["librevenge:number"])
+        res+=getNumber(instr["librevenge:number"]->getDouble(), '.');
+      else if (type=="librevenge-text" && instr["librevenge:text"])
+        res+=std::string("\"")+instr["librevenge:text"]->getStr().cstr()+"\"";
+      else if (type=="librevenge-cell") {
+        if (instr["librevenge:sheet"])
+          res+=std::string(instr["librevenge:sheet"]->getStr().cstr())+".";
+        res+=getCellName(instr, "librevenge:");
+      }
+      else if (type=="librevenge-cells") {
+        if (instr["librevenge:sheet-name"])
+          res+=std::string(instr["librevenge:sheet-name"]->getStr().cstr())+".";
+        res+=getCellName(instr, "librevenge:start-")+":"+getCellName(instr, "librevenge:end-");
+      }
+      else
+        return "";
+    }
+    return res;
+  }
+
+  //! the output
+  std::ostream *m_output;
+  //! the sheet to write
+  int m_sheetToWrite;
+  //! a flag to know if we output formula
+  bool m_generateFormula;
+  //! the field separator
+  char m_fieldSeparator;
+  //! the text separator
+  char m_textSeparator;
+  //! the decimal separator
+  char m_decimalSeparator;
+  //! the date format
+  std::string m_dateFormat;
+  //! the time format
+  std::string m_timeFormat;
+
+  //! the number of sheets
+  int m_numSheets;
+  //! a flag to know if we are in the sheet to write
+  bool m_inSheet;
+  //! the current row
+  std::string m_row;
+  //! the number of times the current row is repeated
+  int m_numRowsRepeated;
+  //! the number of empty rows which are not yet written
+  long m_numEmptyRows;
+  //! the number of fields in the current row
+  int m_numFields;
+  //! the current column
+  int m_column;
+  //! the number of empty cells which are not yet written
+  int m_numEmptyColumns;
+  //! a flag to know if a cell is opened
+  bool m_inCell;
+  //! the current cell properties
+  librevenge::RVNGPropertyList m_cell;
+  //! the current cell text
+  std::string m_cellText;
+  //! the number of paragraphs in the current cell
+  int m_cellParagraph;
+  //! the number of opened zones whose text must be ignored: comment, frame, ...
+  int m_auxiliaryDepth;
+private:
+  CSVStreamGenerator(CSVStreamGenerator const &) = delete;
+  CSVStreamGenerator &operator=(CSVStreamGenerator const &) = delete;
+};
+
 int main(int argc, char *argv[])
 {
   bool printHelp=false;
@@ -165,12 +601,26 @@ int main(int argc, char *argv[])
     return 1;
   }
   auto error=STOFFDocument::STOFF_R_OK;
-  librevenge::RVNGStringVector vec;
+  std::ofstream outFile;
+  std::ostream *out=nullptr;
+  if (!printNumberOfSheet) {
+    if (output) {
+      outFile.open(output);
+      if (!outFile.is_open()) {
+        fprintf(stderr, "ERROR: can not open %s!\n", output);
+        return 1;
+      }
+      out=&outFile;
+    }
+    else
+      out=&std::cout;
+  }
+  int sheet=sheetToConvert>0 ? sheetToConvert-1 : 0;
+  CSVStreamGenerator listenerImpl(out, sheet, generateFormula);
+  listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
+  listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
 
   try {
-    librevenge::RVNGCSVSpreadsheetGenerator listenerImpl(vec, generateFormula);
-    listenerImpl.setSeparators(fieldSeparator, textSeparator, decSeparator);
-    listenerImpl.setDTFormats(dateFormat.c_str(),timeFormat.c_str());
     error= STOFFDocument::parse(&input, &listenerImpl);
   }
   catch (STOFFDocument::Result const &err) {
@@ -192,21 +642,14 @@ int main(int argc, char *argv[])
     return 1;
 
   if (printNumberOfSheet) {
-    std::cout << vec.size() << "\n";
+    std::cout << listenerImpl.getNumSheets() << "\n";
     return 0;
   }
 
-  unsigned page=sheetToConvert>0 ? unsigned(sheetToConvert-1) : 0;
-  if (page>=vec.size()) {
-    fprintf(stderr, "ERROR: can not find page %d!\n", int(page));
+  if (!listenerImpl.hasFoundSheet()) {
+    fprintf(stderr, "ERROR: can not find page %d!\n", sheet);
     return 1;
   }
-  if (!output)
-    std::cout << vec[page].cstr() << std::endl;
-  else {
-    std::ofstream out(output);
-    out << vec[page].cstr() << std::endl;
-  }
   return 0;
 }
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -95,6 +95,8 @@ void SDAParser::parse(librevenge::RVNGDrawingInterface *docInterface)
     checkHeader(nullptr);
     ok = createZones();
     if (ok) {
+      // decode the embedded objects before sending the document
+      StarFileManager::decodeOLEDirectories(m_oleParser);
       createDocument(docInterface);
       if (m_state->m_mainGraphic)
         m_state->m_mainGraphic->sendPages(getGraphicListener());
@@ -122,6 +124,8 @@ void SDAParser::parse(librevenge::RVNGPresentationInterface *docInterface)
     checkHeader(nullptr);
     ok = createZones();
     if (ok) {
+      // decode the embedded objects before sending the document
+      StarFileManager::decodeOLEDirectories(m_oleParser);
       createDocument(docInterface);
       if (m_state->m_mainGraphic)
         m_state->m_mainGraphic->sendPages(getGraphicListener());
@@ -140,6 +144,23 @@ void SDAParser::parse(librevenge::RVNGPresentationInterface *docInterface)
   if (!ok) throw(libstoff::ParseException());
 }
 
+void SDAParser::extractText(STOFFTextExtractorInterface &extractor)
+{
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    ok = createZones();
+    if (ok && m_state->m_mainGraphic)
+      m_state->m_mainGraphic->extractText(extractor);
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDAParser::extractText: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
 bool SDAParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
@@ -168,7 +189,13 @@ void SDAParser::createDocument(librevenge::RVNGDrawingInterface *documentInterfa
   if (!documentInterface) return;
 
   std::vector<STOFFPageSpan> pageList;
-  if (!m_state->m_mainGraphic || !m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages)) {
+  STOFFVec2i const &pageRange=getParserState()->m_pageRange;
+  if (!m_state->m_mainGraphic || !m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages, pageRange)) {
+    if (m_state->m_mainGraphic && pageRange[0]>0) {
+      // the first page is after the last page: do not send a blank page
+      STOFF_DEBUG_MSG(("SDAParser::createDocument: can not find any page in the page range\n"));
+      throw libstoff::ParseException();
+    }
     STOFFPageSpan ps(getPageSpan());
     ps.m_pageSpan=1;
     pageList.push_back(ps);
@@ -189,7 +216,13 @@ void SDAParser::createDocument(librevenge::RVNGPresentationInterface *documentIn
   if (!documentInterface) return;
 
   std::vector<STOFFPageSpan> pageList;
-  if (!m_state->m_mainGraphic || !m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages)) {
+  STOFFVec2i const &pageRange=getParserState()->m_pageRange;
+  if (!m_state->m_mainGraphic || !m_state->m_mainGraphic->updatePageSpans(pageList, m_state->m_numPages, pageRange)) {
+    if (m_state->m_mainGraphic && pageRange[0]>0) {
+      // the first page is after the last page: do not send a blank page
+      STOFF_DEBUG_MSG(("SDAParser::createDocument: can not find any page in the page range\n"));
+      throw libstoff::ParseException();
+    }
     STOFFPageSpan ps(getPageSpan());
     ps.m_pageSpan=1;
     pageList.push_back(ps);
@@ -80,6 +80,8 @@ public:
   void parse(librevenge::RVNGDrawingInterface *documentInterface) final;
   // the main presentation parse function
   void parse(librevenge::RVNGPresentationInterface *documentInterface) final;
+  //! try to send the document's text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor);
 
 protected:
   //! creates the listener which will be associated to the document
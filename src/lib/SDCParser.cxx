@@ -95,6 +95,8 @@ void SDCParser::parse(librevenge::RVNGSpreadsheetInterface *docInterface)
     checkHeader(nullptr);
     ok = createZones();
     if (ok) {
+      // decode the embedded objects before sending the document
+      StarFileManager::decodeOLEDirectories(m_oleParser);
       createDocument(docInterface);
       sendSpreadsheet();
 #ifdef DEBUG
@@ -113,6 +115,23 @@ void SDCParser::parse(librevenge::RVNGSpreadsheetInterface *docInterface)
 }
 
 
+void SDCParser::extractText(STOFFTextExtractorInterface &extractor)
+{
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    ok = createZones();
+    if (ok && m_state->m_mainSpreadsheet)
+      m_state->m_mainSpreadsheet->extractText(extractor);
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDCParser::extractText: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
 bool SDCParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
@@ -130,6 +149,7 @@ bool SDCParser::createZones()
     return false;
   }
   m_state->m_mainSpreadsheet.reset(new StarObjectSpreadsheet(mainObject, false));
+  m_state->m_mainSpreadsheet->setCellWindow(getParserState()->m_cellWindowSheet, getParserState()->m_cellWindow);
   m_state->m_mainSpreadsheet->parse();
   return true;
 }
@@ -162,7 +182,7 @@ bool SDCParser::sendSpreadsheet()
     STOFF_DEBUG_MSG(("SDCParser::sendSpreadsheet: can not find the main spreadsheet\n"));
     return false;
   }
-  return m_state->m_mainSpreadsheet->send(listener);
+  return m_state->m_mainSpreadsheet->send(listener, getParserState()->m_cellWindowSheet, getParserState()->m_cellWindow);
 }
 
 ////////////////////////////////////////////////////////////
@@ -78,6 +78,8 @@ public:
 
   // the main parse function
   void parse(librevenge::RVNGSpreadsheetInterface *documentInterface) override;
+  //! try to send the document's text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor);
 
 protected:
   //! creates the listener which will be associated to the document
@@ -96,6 +96,8 @@ void SDWParser::parse(librevenge::RVNGTextInterface *docInterface)
     checkHeader(nullptr);
     ok = createZones();
     if (ok) {
+      // decode the embedded objects before sending the document
+      StarFileManager::decodeOLEDirectories(m_oleParser);
       createDocument(docInterface);
       if (m_state->m_mainText)
         m_state->m_mainText->sendPages(getTextListener());
@@ -115,6 +117,23 @@ void SDWParser::parse(librevenge::RVNGTextInterface *docInterface)
 }
 
 
+void SDWParser::extractText(STOFFTextExtractorInterface &extractor)
+{
+  if (!getInput().get() || !checkHeader(nullptr))  throw(libstoff::ParseException());
+  bool ok = true;
+  try {
+    ok = createZones();
+    if (ok && m_state->m_mainText)
+      m_state->m_mainText->extractText(extractor);
+    ascii().reset();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("SDWParser::extractText: exception catched when parsing\n"));
+    ok = false;
+  }
+  if (!ok) throw(libstoff::ParseException());
+}
+
 bool SDWParser::createZones()
 {
   m_oleParser.reset(new STOFFOLEParser);
@@ -35,6 +35,8 @@
  * libstoff API: implementation of main interface functions
  */
 
+#include <future>
+
 #include "SDAParser.hxx"
 #include "SDCParser.hxx"
 #include "SDGParser.hxx"
@@ -43,10 +45,14 @@
 
 #include "STOFFHeader.hxx"
 #include "STOFFGraphicDecoder.hxx"
+#include "STOFFOLEParser.hxx"
+#include "STOFFParseControl.hxx"
 #include "STOFFParser.hxx"
 #include "STOFFPropertyHandler.hxx"
 #include "STOFFSpreadsheetDecoder.hxx"
 
+#include "StarObject.hxx"
+
 #include <libstaroffice/libstaroffice.hxx>
 
 /** small namespace use to define private class/method used by STOFFDocument */
@@ -58,6 +64,128 @@ std::shared_ptr<STOFFTextParser> getTextParserFromHeader(STOFFInputStreamPtr &in
 std::shared_ptr<STOFFSpreadsheetParser> getSpreadsheetParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd);
 STOFFHeader *getHeader(STOFFInputStreamPtr &input, bool strict);
 bool checkHeader(STOFFInputStreamPtr &input, STOFFHeader &header, bool strict);
+std::shared_ptr<StarObject> getMainObject(librevenge::RVNGInputStream *input, bool skipBinaryData, STOFFDocument::Result &error);
+
+//! returns the parser which can convert the document in a drawing
+std::shared_ptr<STOFFGraphicParser> getParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd, librevenge::RVNGDrawingInterface *)
+{
+  return getGraphicParserFromHeader(input, header, passwd);
+}
+//! returns the parser which can convert the document in a presentation
+std::shared_ptr<STOFFGraphicParser> getParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd, librevenge::RVNGPresentationInterface *)
+{
+  return getPresentationParserFromHeader(input, header, passwd);
+}
+//! returns the parser which can convert the document in a spreadsheet
+std::shared_ptr<STOFFSpreadsheetParser> getParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd, librevenge::RVNGSpreadsheetInterface *)
+{
+  return getSpreadsheetParserFromHeader(input, header, passwd);
+}
+//! returns the parser which can convert the document in a text
+std::shared_ptr<STOFFTextParser> getParserFromHeader(STOFFInputStreamPtr &input, STOFFHeader *header, char const *passwd, librevenge::RVNGTextInterface *)
+{
+  return getTextParserFromHeader(input, header, passwd);
+}
+
+/** the main parse function: parses the input using documentInterface, control (if defined) is
+    used to follow the parsing and to stop it, pageRange defines the pages to send (for the draw and
+    presentation documents), cellWindowSheet and cellWindow the cells to send (for the
+    spreadsheet documents) */
+template<class Interface>
+STOFFDocument::Result parse(librevenge::RVNGInputStream *input, Interface *documentInterface, char const *password, unsigned options, std::shared_ptr<STOFFParseControl> const &control,
+                            STOFFVec2i const &pageRange=STOFFVec2i(0,-1), int cellWindowSheet=-1, STOFFBox2i const &cellWindow=STOFFBox2i())
+try
+{
+  if (!input)
+    return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  ip->setSkipBinaryData((options&STOFFDocument::STOFF_O_SKIP_BINARY_DATA)!=0);
+  ip->setRecordEmbeddedObjects((options&STOFFDocument::STOFF_O_RECORD_EMBEDDED_OBJECTS)!=0);
+  if (control) {
+    ip->setParseControl(control);
+    control->setNumBytesTotal(ip->size());
+  }
+  std::shared_ptr<STOFFHeader> header(getHeader(ip, false));
+
+  if (!header.get()) return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+  auto parser=getParserFromHeader(ip, header.get(), password, documentInterface);
+  if (!parser) return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+  parser->setPageRange(pageRange);
+  parser->setCellWindow(cellWindowSheet, cellWindow);
+  parser->parse(documentInterface);
+  // the parsers ignore the damaged zones, so a cancelled parsing can end normally
+  if (control && control->isCancelled())
+    return STOFFDocument::STOFF_R_CANCELLED;
+  return STOFFDocument::STOFF_R_OK;
+}
+catch (libstoff::FileException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: File exception trapped\n"));
+  return STOFFDocument::STOFF_R_FILE_ACCESS_ERROR;
+}
+catch (libstoff::ParseException)
+{
+  if (control && control->isCancelled()) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parse: the parsing is cancelled\n"));
+    return STOFFDocument::STOFF_R_CANCELLED;
+  }
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
+  return STOFFDocument::STOFF_R_PARSE_ERROR;
+}
+catch (libstoff::WrongPasswordException)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
+  return STOFFDocument::STOFF_R_PASSWORD_MISSMATCH_ERROR;
+}
+catch (...)
+{
+  //fixme: too generic
+  if (control && control->isCancelled()) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parse: the parsing is cancelled\n"));
+    return STOFFDocument::STOFF_R_CANCELLED;
+  }
+  STOFF_DEBUG_MSG(("STOFFDocument::parse: Unknown exception trapped\n"));
+  return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+}
+}
+
+//! the internal data of a STOFFParseHandle
+struct STOFFParseHandle::Data {
+  //! constructor
+  Data()
+    : m_control(std::make_shared<STOFFParseControl>())
+    , m_result()
+  {
+  }
+  //! the parse control
+  std::shared_ptr<STOFFParseControl> m_control;
+  //! the parsing result
+  std::shared_future<STOFFDocument::Result> m_result;
+};
+
+namespace STOFFDocumentInternal
+{
+//! launches parse in a new thread (or directly if no thread can be created)
+template<class Interface>
+std::shared_ptr<STOFFParseHandle> parseAsync(librevenge::RVNGInputStream *input, Interface *documentInterface, char const *password, unsigned options)
+{
+  auto data=std::make_shared<STOFFParseHandle::Data>();
+  auto control=data->m_control;
+  auto task=[input,documentInterface,password,options,control]() {
+    return parse(input, documentInterface, password, options, control);
+  };
+  try {
+    data->m_result=std::async(std::launch::async, task).share();
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("STOFFDocumentInternal::parseAsync: can not create a thread, parse the document directly\n"));
+    std::promise<STOFFDocument::Result> result;
+    result.set_value(task());
+    data->m_result=result.get_future().share();
+  }
+  return std::make_shared<STOFFParseHandle>(data);
+}
 }
 
 STOFFDocument::Confidence STOFFDocument::isFileFormatSupported(librevenge::RVNGInputStream *input, Kind &kind)
@@ -91,154 +219,264 @@ catch (...)
 }
 
 STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password)
-try
 {
-  if (!input)
+  return parse(input, documentInterface, password, STOFF_O_NONE);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password, unsigned options)
+{
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>());
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password, unsigned options, int firstPage, int lastPage)
+{
+  if (firstPage<1 || (lastPage>=0 && lastPage<firstPage)) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parse: the page range %d-%d is bad\n", firstPage, lastPage));
     return STOFF_R_UNKNOWN_ERROR;
+  }
+  STOFFVec2i pageRange(firstPage-1, lastPage<0 ? -1 : lastPage-1);
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>(), pageRange);
+}
 
-  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
-  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
+std::shared_ptr<STOFFParseHandle> STOFFDocument::parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGDrawingInterface *documentInterface, char const *password, unsigned options)
+{
+  return STOFFDocumentInternal::parseAsync(input, documentInterface, password, options);
+}
 
-  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getGraphicParserFromHeader(ip, header.get(), password);
-  if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-  return STOFF_R_OK;
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, password, STOFF_O_NONE);
 }
-catch (libstoff::FileException)
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password, unsigned options)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: File exception trapped\n"));
-  return STOFF_R_FILE_ACCESS_ERROR;
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>());
 }
-catch (libstoff::ParseException)
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password, unsigned options, int firstPage, int lastPage)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
-  return STOFF_R_PARSE_ERROR;
+  if (firstPage<1 || (lastPage>=0 && lastPage<firstPage)) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parse: the page range %d-%d is bad\n", firstPage, lastPage));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
+  STOFFVec2i pageRange(firstPage-1, lastPage<0 ? -1 : lastPage-1);
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>(), pageRange);
 }
-catch (libstoff::WrongPasswordException)
+
+std::shared_ptr<STOFFParseHandle> STOFFDocument::parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password, unsigned options)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
-  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
+  return STOFFDocumentInternal::parseAsync(input, documentInterface, password, options);
 }
-catch (...)
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password)
 {
-  //fixme: too generic
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Unknown exception trapped\n"));
-  return STOFF_R_UNKNOWN_ERROR;
+  return parse(input, documentInterface, password, STOFF_O_NONE);
 }
 
-STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGPresentationInterface *documentInterface, char const *password)
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password, unsigned options)
+{
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>());
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password, unsigned options,
+    int sheet, int firstColumn, int firstRow, int lastColumn, int lastRow)
+{
+  if (sheet<0 || firstColumn<0 || firstRow<0 || lastColumn<firstColumn || lastRow<firstRow) {
+    STOFF_DEBUG_MSG(("STOFFDocument::parse: the cell window %d:%dx%d-%dx%d is bad\n", sheet, firstColumn, firstRow, lastColumn, lastRow));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
+  STOFFBox2i window(STOFFVec2i(firstColumn, firstRow), STOFFVec2i(lastColumn, lastRow));
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>(), STOFFVec2i(0,-1), sheet, window);
+}
+
+std::shared_ptr<STOFFParseHandle> STOFFDocument::parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password, unsigned options)
+{
+  return STOFFDocumentInternal::parseAsync(input, documentInterface, password, options);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
+{
+  return parse(input, documentInterface, password, STOFF_O_NONE);
+}
+
+STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password, unsigned options)
+{
+  return STOFFDocumentInternal::parse(input, documentInterface, password, options, std::shared_ptr<STOFFParseControl>());
+}
+
+std::shared_ptr<STOFFParseHandle> STOFFDocument::parseAsync(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password, unsigned options)
+{
+  return STOFFDocumentInternal::parseAsync(input, documentInterface, password, options);
+}
+
+STOFFDocument::Result STOFFDocument::extractText(librevenge::RVNGInputStream *input, STOFFTextExtractorInterface *extractor, char const *password)
 try
 {
-  if (!input)
+  if (!input || !extractor)
     return STOFF_R_UNKNOWN_ERROR;
 
   STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  ip->setSkipBinaryData(true);
   std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
 
   if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getPresentationParserFromHeader(ip, header.get(), password);
-  if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  switch (header->getKind()) {
+  case STOFF_K_TEXT: {
+    SDWParser parser(ip, header.get());
+    if (password) parser.setDocumentPassword(password);
+    parser.extractText(*extractor);
+    break;
+  }
+  case STOFF_K_SPREADSHEET: {
+    SDCParser parser(ip, header.get());
+    if (password) parser.setDocumentPassword(password);
+    parser.extractText(*extractor);
+    break;
+  }
+  case STOFF_K_DRAW:
+  case STOFF_K_PRESENTATION: {
+    SDAParser parser(ip, header.get());
+    if (password) parser.setDocumentPassword(password);
+    parser.extractText(*extractor);
+    break;
+  }
+  case STOFF_K_UNKNOWN:
+  case STOFF_K_BITMAP:
+  case STOFF_K_CHART:
+  case STOFF_K_DATABASE:
+  case STOFF_K_MATH:
+  case STOFF_K_GRAPHIC:
+#if !defined(__clang__)
+  default:
+#endif
+    STOFF_DEBUG_MSG(("STOFFDocument::extractText: unexpected document kind\n"));
+    return STOFF_R_UNKNOWN_ERROR;
+  }
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: File exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: File exception trapped\n"));
   return STOFF_R_FILE_ACCESS_ERROR;
 }
 catch (libstoff::ParseException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
 catch (libstoff::WrongPasswordException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Parse password trapped\n"));
   return STOFF_R_PASSWORD_MISSMATCH_ERROR;
 }
 catch (...)
 {
   //fixme: too generic
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Unknown exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::extractText: Unknown exception trapped\n"));
   return STOFF_R_UNKNOWN_ERROR;
 }
 
-STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGSpreadsheetInterface *documentInterface, char const *password)
+STOFFDocument::Result STOFFDocument::getMetaData(librevenge::RVNGInputStream *input, librevenge::RVNGPropertyList &metaData)
 try
 {
-  if (!input)
-    return STOFF_R_UNKNOWN_ERROR;
-
-  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
-  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
-
-  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getSpreadsheetParserFromHeader(ip, header.get(), password);
-  if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
+  metaData.clear();
+  STOFFDocument::Result error;
+  auto mainObject=STOFFDocumentInternal::getMainObject(input, true, error);
+  if (!mainObject)
+    return error;
+  if (!mainObject->readDocumentInformation())
+    return STOFF_R_PARSE_ERROR;
+  metaData=mainObject->getMetaData();
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: File exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::getMetaData: File exception trapped\n"));
   return STOFF_R_FILE_ACCESS_ERROR;
 }
 catch (libstoff::ParseException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::getMetaData: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
-catch (libstoff::WrongPasswordException)
-{
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
-  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
-}
 catch (...)
 {
   //fixme: too generic
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Unknown exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::getMetaData: Unknown exception trapped\n"));
   return STOFF_R_UNKNOWN_ERROR;
 }
 
-STOFFDocument::Result STOFFDocument::parse(librevenge::RVNGInputStream *input, librevenge::RVNGTextInterface *documentInterface, char const *password)
+STOFFDocument::Result STOFFDocument::getThumbnail(librevenge::RVNGInputStream *input, librevenge::RVNGBinaryData &data, librevenge::RVNGString &mimeType)
 try
 {
-  if (!input)
-    return STOFF_R_UNKNOWN_ERROR;
-
-  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
-  std::shared_ptr<STOFFHeader> header(STOFFDocumentInternal::getHeader(ip, false));
-
-  if (!header.get()) return STOFF_R_UNKNOWN_ERROR;
-  auto parser=STOFFDocumentInternal::getTextParserFromHeader(ip, header.get(), password);
-  if (!parser) return STOFF_R_UNKNOWN_ERROR;
-  parser->parse(documentInterface);
-
+  data.clear();
+  mimeType.clear();
+  STOFFDocument::Result error;
+  auto mainObject=STOFFDocumentInternal::getMainObject(input, false, error);
+  if (!mainObject)
+    return error;
+  std::string type;
+  if (!mainObject->readDocumentPreview(data, type))
+    return STOFF_R_PARSE_ERROR;
+  mimeType=type.c_str();
   return STOFF_R_OK;
 }
 catch (libstoff::FileException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: File exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::getThumbnail: File exception trapped\n"));
   return STOFF_R_FILE_ACCESS_ERROR;
 }
 catch (libstoff::ParseException)
 {
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::getThumbnail: Parse exception trapped\n"));
   return STOFF_R_PARSE_ERROR;
 }
-catch (libstoff::WrongPasswordException)
-{
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Parse password trapped\n"));
-  return STOFF_R_PASSWORD_MISSMATCH_ERROR;
-}
 catch (...)
 {
   //fixme: too generic
-  STOFF_DEBUG_MSG(("STOFFDocument::parse: Unknown exception trapped\n"));
+  STOFF_DEBUG_MSG(("STOFFDocument::getThumbnail: Unknown exception trapped\n"));
   return STOFF_R_UNKNOWN_ERROR;
 }
 
+////////////////////////////////////////////////////////////
+// STOFFParseHandle
+////////////////////////////////////////////////////////////
+STOFFParseHandle::STOFFParseHandle(std::shared_ptr<STOFFParseHandle::Data> const &data)
+  : m_data(data)
+{
+}
+
+STOFFParseHandle::~STOFFParseHandle()
+{
+  if (!m_data || !m_data->m_result.valid()) return;
+  if (!isFinished()) cancel();
+  m_data->m_result.wait();
+}
+
+void STOFFParseHandle::cancel()
+{
+  if (m_data) m_data->m_control->cancel();
+}
+
+bool STOFFParseHandle::isFinished() const
+{
+  if (!m_data || !m_data->m_result.valid()) return true;
+  return m_data->m_result.wait_for(std::chrono::seconds(0))==std::future_status::ready;
+}
+
+STOFFDocument::Result STOFFParseHandle::wait()
+{
+  if (!m_data || !m_data->m_result.valid()) return STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+  return m_data->m_result.get();
+}
+
+void STOFFParseHandle::getProgress(long &numBytesRead, long &numBytesTotal, int &numPagesSent) const
+{
+  numBytesRead=numBytesTotal=0;
+  numPagesSent=0;
+  if (m_data) m_data->m_control->getProgress(numBytesRead, numBytesTotal, numPagesSent);
+}
+
 bool STOFFDocument::decodeGraphic(librevenge::RVNGBinaryData const &binary, librevenge::RVNGDrawingInterface *paintInterface)
 try
 {
@@ -273,6 +511,38 @@ catch (...)
   return false;
 }
 
+bool STOFFDocument::decodeGraphic(librevenge::RVNGPropertyListVector const &calls, librevenge::RVNGDrawingInterface *paintInterface)
+try
+{
+  if (!paintInterface || calls.empty()) {
+    STOFF_DEBUG_MSG(("STOFFDocument::decodeGraphic: called with no calls or no converter\n"));
+    return false;
+  }
+  STOFFGraphicDecoder tmpHandler(paintInterface);
+  return tmpHandler.replayCalls(calls);
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::decodeGraphic: unknown error\n"));
+  return false;
+}
+
+bool STOFFDocument::decodeSpreadsheet(librevenge::RVNGPropertyListVector const &calls, librevenge::RVNGSpreadsheetInterface *sheetInterface)
+try
+{
+  if (!sheetInterface || calls.empty()) {
+    STOFF_DEBUG_MSG(("STOFFDocument::decodeSpreadsheet: called with no calls or no converter\n"));
+    return false;
+  }
+  STOFFSpreadsheetDecoder tmpHandler(sheetInterface);
+  return tmpHandler.replayCalls(calls);
+}
+catch (...)
+{
+  STOFF_DEBUG_MSG(("STOFFDocument::decodeSpreadsheet: unknown error\n"));
+  return false;
+}
+
 bool STOFFDocument::decodeText(librevenge::RVNGBinaryData const &, librevenge::RVNGTextInterface *)
 {
   STOFF_DEBUG_MSG(("STOFFDocument::decodeText: unimplemented\n"));
@@ -281,6 +551,32 @@ bool STOFFDocument::decodeText(librevenge::RVNGBinaryData const &, librevenge::R
 
 namespace STOFFDocumentInternal
 {
+/** returns the main object of an OLE document without parsing it, or an empty pointer and the error.
+    If skipBinaryData is set, the pictures' data are not decoded */
+std::shared_ptr<StarObject> getMainObject(librevenge::RVNGInputStream *input, bool skipBinaryData, STOFFDocument::Result &error)
+{
+  error=STOFFDocument::STOFF_R_UNKNOWN_ERROR;
+  if (!input)
+    return std::shared_ptr<StarObject>();
+
+  STOFFInputStreamPtr ip(new STOFFInputStream(input, false));
+  ip->setSkipBinaryData(skipBinaryData);
+  std::shared_ptr<STOFFHeader> header(getHeader(ip, false));
+  if (!header.get()) return std::shared_ptr<StarObject>();
+  error=STOFFDocument::STOFF_R_OLE_ERROR;
+  if (!ip->isStructured()) {
+    STOFF_DEBUG_MSG(("STOFFDocumentInternal::getMainObject: the file is not an OLE file\n"));
+    return std::shared_ptr<StarObject>();
+  }
+  auto oleParser=std::make_shared<STOFFOLEParser>();
+  auto mainOle=oleParser->parse(ip) ? oleParser->getDirectory("/") : std::shared_ptr<STOFFOLEParser::OleDirectory>();
+  if (!mainOle) {
+    STOFF_DEBUG_MSG(("STOFFDocumentInternal::getMainObject: can not find the main ole\n"));
+    return std::shared_ptr<StarObject>();
+  }
+  return std::make_shared<StarObject>(nullptr, oleParser, mainOle);
+}
+
 /** return the header corresponding to an input. Or 0L if no input are found */
 STOFFHeader *getHeader(STOFFInputStreamPtr &ip, bool strict)
 try
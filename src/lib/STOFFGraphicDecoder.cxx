@@ -33,8 +33,6 @@
 * instead of those above.
 */
 
-#include <string.h>
-
 #include <librevenge/librevenge.h>
 #include <libstaroffice/libstaroffice.hxx>
 
@@ -44,215 +42,174 @@
 
 #include "STOFFGraphicDecoder.hxx"
 
-void STOFFGraphicDecoder::insertElement(const char *psName)
+void STOFFGraphicDecoder::insertElement(Tag tag)
 {
   if (!m_output) return;
-  int len=psName ? int(strlen(psName)) : 0;
-  if (!len) {
-    STOFF_DEBUG_MSG(("STOFFGraphicDecoder::insertElement: called without name\n"));
-    return;
-  }
-
-  bool ok=true;
-  switch (psName[0]) {
-  case 'C':
-    if (len>=6 && strncmp(psName,"Close",5)==0) {
-      psName+=5;
-      if (strcmp(psName,"Group")==0)
-        m_output->closeGroup();
-      else if (strcmp(psName,"Link")==0)
-        m_output->closeLink();
-      else if (strcmp(psName,"ListElement")==0)
-        m_output->closeListElement();
-      else if (strcmp(psName,"OrderedListLevel")==0)
-        m_output->closeOrderedListLevel();
-      else if (strcmp(psName,"Paragraph")==0)
-        m_output->closeParagraph();
-      else if (strcmp(psName,"Span")==0)
-        m_output->closeSpan();
-      else if (strcmp(psName,"TableCell")==0)
-        m_output->closeTableCell();
-      else if (strcmp(psName,"TableRow")==0)
-        m_output->closeTableRow();
-      else if (strcmp(psName,"UnorderedListLevel")==0)
-        m_output->closeUnorderedListLevel();
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'E':
-    if (len>=4 && strncmp(psName,"End",3)==0) {
-      psName+=3;
-      if (strcmp(psName,"Document")==0)
-        m_output->endDocument();
-      else if (strcmp(psName,"EmbeddedGraphics")==0)
-        m_output->endEmbeddedGraphics();
-      else if (strcmp(psName,"Layer")==0)
-        m_output->endLayer();
-      else if (strcmp(psName,"MasterPage")==0)
-        m_output->endMasterPage();
-      else if (strcmp(psName,"Page")==0)
-        m_output->endPage();
-      else if (strcmp(psName,"TableObject")==0)
-        m_output->endTableObject();
-      else if (strcmp(psName,"TextObject")==0)
-        m_output->endTextObject();
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (len>=7 && strncmp(psName,"Insert",6)==0) {
-      psName+=6;
-      if (strcmp(psName,"LineBreak")==0)
-        m_output->insertLineBreak();
-      else if (strcmp(psName,"Space")==0)
-        m_output->insertSpace();
-      else if (strcmp(psName,"Tab")==0)
-        m_output->insertTab();
-      else
-        ok=false;
-    }
-    else
-      ok=false;
+  switch (tag) {
+  case T_CloseGroup:
+    m_output->closeGroup();
+    break;
+  case T_CloseLink:
+    m_output->closeLink();
+    break;
+  case T_CloseListElement:
+    m_output->closeListElement();
+    break;
+  case T_CloseOrderedListLevel:
+    m_output->closeOrderedListLevel();
+    break;
+  case T_CloseParagraph:
+    m_output->closeParagraph();
+    break;
+  case T_CloseSpan:
+    m_output->closeSpan();
+    break;
+  case T_CloseTableCell:
+    m_output->closeTableCell();
+    break;
+  case T_CloseTableRow:
+    m_output->closeTableRow();
+    break;
+  case T_CloseUnorderedListLevel:
+    m_output->closeUnorderedListLevel();
+    break;
+  case T_EndDocument:
+    m_output->endDocument();
+    break;
+  case T_EndEmbeddedGraphics:
+    m_output->endEmbeddedGraphics();
+    break;
+  case T_EndLayer:
+    m_output->endLayer();
+    break;
+  case T_EndMasterPage:
+    m_output->endMasterPage();
+    break;
+  case T_EndPage:
+    m_output->endPage();
+    break;
+  case T_EndTableObject:
+    m_output->endTableObject();
+    break;
+  case T_EndTextObject:
+    m_output->endTextObject();
+    break;
+  case T_InsertLineBreak:
+    m_output->insertLineBreak();
+    break;
+  case T_InsertSpace:
+    m_output->insertSpace();
+    break;
+  case T_InsertTab:
+    m_output->insertTab();
+    break;
+  case T_StartEmbeddedGraphics: // libstaroffice 0.0.6 or older used this name to store endEmbeddedGraphics
+    m_output->endEmbeddedGraphics();
     break;
   default:
-    ok=false;
+    STOFF_DEBUG_MSG(("STOFFGraphicDecoder::insertElement: called with unexpected tag %s\n", getTagName(tag)));
     break;
   }
-  if (!ok) {
-    STOFF_DEBUG_MSG(("STOFFGraphicDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
-void STOFFGraphicDecoder::insertElement(const char *psName, const librevenge::RVNGPropertyList &propList)
+void STOFFGraphicDecoder::insertElement(Tag tag, const librevenge::RVNGPropertyList &propList)
 {
   if (!m_output) return;
-  int len=psName ? int(strlen(psName)) : 0;
-  if (!len) {
-    STOFF_DEBUG_MSG(("STOFFGraphicDecoder::insertElement: called without any name\n"));
-    return;
-  }
-
-  bool ok=true;
-  switch (psName[0]) {
-  case 'D':
-    if (len>=7 && strncmp(psName,"Define",6)==0) {
-      psName+=6;
-      if (strcmp(psName,"CharacterStyle")==0)
-        m_output->defineCharacterStyle(propList);
-      else if (strcmp(psName,"EmbeddedFont")==0)
-        m_output->defineEmbeddedFont(propList);
-      else if (strcmp(psName,"ParagraphStyle")==0)
-        m_output->defineParagraphStyle(propList);
-      else
-        ok=false;
-    }
-    else if (len>=5 && strncmp(psName,"Draw",4)==0) {
-      psName+=4;
-      if (strcmp(psName,"Connector")==0)
-        m_output->drawConnector(propList);
-      else if (strcmp(psName,"Ellipse")==0)
-        m_output->drawEllipse(propList);
-      else if (strcmp(psName,"GraphicObject")==0)
-        m_output->drawGraphicObject(propList);
-      else if (strcmp(psName,"Path")==0)
-        m_output->drawPath(propList);
-      else if (strcmp(psName,"Polygon")==0)
-        m_output->drawPolygon(propList);
-      else if (strcmp(psName,"Polyline")==0)
-        m_output->drawPolyline(propList);
-      else if (strcmp(psName,"Rectangle")==0)
-        m_output->drawRectangle(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (len>=7 && strncmp(psName,"Insert",6)==0) {
-      psName+=6;
-      if (strcmp(psName,"CoveredTableCell")==0)
-        m_output->insertCoveredTableCell(propList);
-      else if (strcmp(psName,"Field")==0)
-        m_output->insertField(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'O':
-    if (len>=5 && strncmp(psName,"Open",4)==0) {
-      psName+=4;
-      if (strcmp(psName,"Group")==0)
-        m_output->openGroup(propList);
-      else if (strcmp(psName,"Link")==0)
-        m_output->openLink(propList);
-      else if (strcmp(psName,"ListElement")==0)
-        m_output->openListElement(propList);
-      else if (strcmp(psName,"OrderedListLevel")==0)
-        m_output->openOrderedListLevel(propList);
-      else if (strcmp(psName,"Paragraph")==0)
-        m_output->openParagraph(propList);
-      else if (strcmp(psName,"Span")==0)
-        m_output->openSpan(propList);
-      else if (strcmp(psName,"TableCell")==0)
-        m_output->openTableCell(propList);
-      else if (strcmp(psName,"TableRow")==0)
-        m_output->openTableRow(propList);
-      else if (strcmp(psName,"UnorderedListLevel")==0)
-        m_output->openUnorderedListLevel(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
-    break;
-  case 'S':
-    if (len>=4 && strncmp(psName,"Set",3)==0) {
-      psName+=3;
-      if (strcmp(psName,"DocumentMetaData")==0)
-        m_output->setDocumentMetaData(propList);
-      else if (strcmp(psName,"Style")==0)
-        m_output->setStyle(propList);
-      else
-        ok=false;
-    }
-    else if (len>=6 && strncmp(psName,"Start",5)==0) {
-      psName+=5;
-      if (strcmp(psName,"Document")==0)
-        m_output->startDocument(propList);
-      else if (strcmp(psName,"EmbeddedGraphics")==0)
-        m_output->startEmbeddedGraphics(propList);
-      else if (strcmp(psName,"Layer")==0)
-        m_output->startLayer(propList);
-      else if (strcmp(psName,"MasterPage")==0)
-        m_output->startMasterPage(propList);
-      else if (strcmp(psName,"Page")==0)
-        m_output->startPage(propList);
-      else if (strcmp(psName,"TableObject")==0)
-        m_output->startTableObject(propList);
-      else if (strcmp(psName,"TextObject")==0)
-        m_output->startTextObject(propList);
-      else
-        ok=false;
-    }
-    else
-      ok=false;
+  switch (tag) {
+  case T_DefineCharacterStyle:
+    m_output->defineCharacterStyle(propList);
+    break;
+  case T_DefineEmbeddedFont:
+    m_output->defineEmbeddedFont(propList);
+    break;
+  case T_DefineParagraphStyle:
+    m_output->defineParagraphStyle(propList);
+    break;
+  case T_DrawConnector:
+    m_output->drawConnector(propList);
+    break;
+  case T_DrawEllipse:
+    m_output->drawEllipse(propList);
+    break;
+  case T_DrawGraphicObject:
+    m_output->drawGraphicObject(propList);
+    break;
+  case T_DrawPath:
+    m_output->drawPath(propList);
+    break;
+  case T_DrawPolygon:
+    m_output->drawPolygon(propList);
+    break;
+  case T_DrawPolyline:
+    m_output->drawPolyline(propList);
+    break;
+  case T_DrawRectangle:
+    m_output->drawRectangle(propList);
+    break;
+  case T_InsertCoveredTableCell:
+    m_output->insertCoveredTableCell(propList);
+    break;
+  case T_InsertField:
+    m_output->insertField(propList);
+    break;
+  case T_OpenGroup:
+    m_output->openGroup(propList);
+    break;
+  case T_OpenLink:
+    m_output->openLink(propList);
+    break;
+  case T_OpenListElement:
+    m_output->openListElement(propList);
+    break;
+  case T_OpenOrderedListLevel:
+    m_output->openOrderedListLevel(propList);
+    break;
+  case T_OpenParagraph:
+    m_output->openParagraph(propList);
+    break;
+  case T_OpenSpan:
+    m_output->openSpan(propList);
+    break;
+  case T_OpenTableCell:
+    m_output->openTableCell(propList);
+    break;
+  case T_OpenTableRow:
+    m_output->openTableRow(propList);
+    break;
+  case T_OpenUnorderedListLevel:
+    m_output->openUnorderedListLevel(propList);
+    break;
+  case T_SetDocumentMetaData:
+    m_output->setDocumentMetaData(propList);
+    break;
+  case T_SetStyle:
+    m_output->setStyle(propList);
+    break;
+  case T_StartDocument:
+    m_output->startDocument(propList);
+    break;
+  case T_StartEmbeddedGraphics:
+    m_output->startEmbeddedGraphics(propList);
+    break;
+  case T_StartLayer:
+    m_output->startLayer(propList);
+    break;
+  case T_StartMasterPage:
+    m_output->startMasterPage(propList);
+    break;
+  case T_StartPage:
+    m_output->startPage(propList);
+    break;
+  case T_StartTableObject:
+    m_output->startTableObject(propList);
+    break;
+  case T_StartTextObject:
+    m_output->startTextObject(propList);
     break;
   default:
-    ok=false;
+    STOFF_DEBUG_MSG(("STOFFGraphicDecoder::insertElement: called with unexpected tag %s\n", getTagName(tag)));
     break;
   }
-  if (!ok) {
-    STOFF_DEBUG_MSG(("STOFFGraphicDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
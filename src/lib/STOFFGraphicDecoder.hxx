@@ -56,12 +56,9 @@ public:
   ~STOFFGraphicDecoder() override {}
 
   /** insert an element */
-  void insertElement(const char *psName) override;
+  void insertElement(Tag tag) override;
   /** insert an element ( with a librevenge::RVNGPropertyList ) */
-  void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList) override;
-  /** insert an element ( with a librevenge::RVNGPropertyListVector parameter ) */
-  void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList,
-                     const librevenge::RVNGPropertyListVector &vector);
+  void insertElement(Tag tag, const librevenge::RVNGPropertyList &xPropList) override;
   /** insert a sequence of character */
   void characters(const librevenge::RVNGString &sCharacters) override
   {
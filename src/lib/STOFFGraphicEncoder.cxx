@@ -54,8 +54,10 @@ namespace STOFFGraphicEncoderInternal
 //! the state of a STOFFGraphicEncoder
 struct State {
   //! constructor
-  State() : m_encoder()
+  explicit State(bool recordCalls)
+    : m_encoder()
   {
+    m_encoder.setRecordCalls(recordCalls);
   }
   //! the encoder
   STOFFPropertyHandlerEncoder m_encoder;
@@ -63,9 +65,9 @@ struct State {
 
 }
 
-STOFFGraphicEncoder::STOFFGraphicEncoder()
+STOFFGraphicEncoder::STOFFGraphicEncoder(bool recordCalls)
   : librevenge::RVNGDrawingInterface()
-  , m_state(new STOFFGraphicEncoderInternal::State)
+  , m_state(new STOFFGraphicEncoderInternal::State(recordCalls))
 {
 }
 
@@ -79,172 +81,173 @@ bool STOFFGraphicEncoder::getBinaryResult(STOFFEmbeddedObject &result)
   if (!m_state->m_encoder.getData(data))
     return false;
   result=STOFFEmbeddedObject(data, "image/stoff-odg");
+  result.m_callList=m_state->m_encoder.getRecordedCalls();
   return true;
 }
 
 void STOFFGraphicEncoder::startDocument(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartDocument", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartDocument, list);
 }
 
 void STOFFGraphicEncoder::endDocument()
 {
-  m_state->m_encoder.insertElement("EndDocument");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndDocument);
 }
 
 void STOFFGraphicEncoder::setDocumentMetaData(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("SetDocumentMetaData", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_SetDocumentMetaData, list);
 }
 
 void STOFFGraphicEncoder::defineEmbeddedFont(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineEmbeddedFont", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineEmbeddedFont, list);
 }
 
 void STOFFGraphicEncoder::startPage(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartPage", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartPage, list);
 }
 
 void STOFFGraphicEncoder::endPage()
 {
-  m_state->m_encoder.insertElement("EndPage");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndPage);
 }
 
 void STOFFGraphicEncoder::startMasterPage(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartMasterPage", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartMasterPage, list);
 }
 
 void STOFFGraphicEncoder::endMasterPage()
 {
-  m_state->m_encoder.insertElement("EndMasterPage");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndMasterPage);
 }
 
 void STOFFGraphicEncoder::setStyle(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("SetStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_SetStyle, list);
 }
 
 void STOFFGraphicEncoder::startLayer(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartLayer", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartLayer, list);
 }
 
 void STOFFGraphicEncoder::endLayer()
 {
-  m_state->m_encoder.insertElement("EndLayer");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndLayer);
 }
 
 void STOFFGraphicEncoder::startEmbeddedGraphics(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartEmbeddedGraphics", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartEmbeddedGraphics, list);
 }
 
 void STOFFGraphicEncoder::endEmbeddedGraphics()
 {
-  m_state->m_encoder.insertElement("StartEmbeddedGraphics");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndEmbeddedGraphics);
 }
 
 void STOFFGraphicEncoder::openGroup(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenGroup", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenGroup, list);
 }
 
 void STOFFGraphicEncoder::closeGroup()
 {
-  m_state->m_encoder.insertElement("CloseGroup");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseGroup);
 }
 
 void STOFFGraphicEncoder::drawRectangle(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawRectangle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawRectangle, list);
 }
 
 void STOFFGraphicEncoder::drawEllipse(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawEllipse", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawEllipse, list);
 }
 
 void STOFFGraphicEncoder::drawPolygon(const ::librevenge::RVNGPropertyList &vertices)
 {
-  m_state->m_encoder.insertElement("DrawPolygon", vertices);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawPolygon, vertices);
 }
 
 void STOFFGraphicEncoder::drawPolyline(const ::librevenge::RVNGPropertyList &vertices)
 {
-  m_state->m_encoder.insertElement("DrawPolyline", vertices);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawPolyline, vertices);
 }
 
 void STOFFGraphicEncoder::drawPath(const ::librevenge::RVNGPropertyList &path)
 {
-  m_state->m_encoder.insertElement("DrawPath", path);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawPath, path);
 }
 
 void STOFFGraphicEncoder::drawConnector(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawConnector", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawConnector, list);
 }
 
 void STOFFGraphicEncoder::drawGraphicObject(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawGraphicObject", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawGraphicObject, list);
 }
 
 void STOFFGraphicEncoder::startTextObject(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartTextObject", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartTextObject, list);
 }
 
 void STOFFGraphicEncoder::endTextObject()
 {
-  m_state->m_encoder.insertElement("EndTextObject");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndTextObject);
 }
 
 void STOFFGraphicEncoder::startTableObject(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartTableObject", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartTableObject, list);
 }
 
 void STOFFGraphicEncoder::endTableObject()
 {
-  m_state->m_encoder.insertElement("EndTableObject");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndTableObject);
 }
 
 void STOFFGraphicEncoder::openTableRow(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenTableRow", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenTableRow, list);
 }
 
 void STOFFGraphicEncoder::closeTableRow()
 {
-  m_state->m_encoder.insertElement("CloseTableRow");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseTableRow);
 }
 
 void STOFFGraphicEncoder::openTableCell(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenTableCell", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenTableCell, list);
 }
 
 void STOFFGraphicEncoder::closeTableCell()
 {
-  m_state->m_encoder.insertElement("CloseTableCell");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseTableCell);
 }
 
 void STOFFGraphicEncoder::insertCoveredTableCell(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertCoveredTableCell", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertCoveredTableCell, list);
 }
 
 void STOFFGraphicEncoder::insertTab()
 {
-  m_state->m_encoder.insertElement("InsertTab");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertTab);
 }
 
 void STOFFGraphicEncoder::insertSpace()
 {
-  m_state->m_encoder.insertElement("InsertSpace");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertSpace);
 }
 
 void STOFFGraphicEncoder::insertText(const librevenge::RVNGString &text)
@@ -254,82 +257,82 @@ void STOFFGraphicEncoder::insertText(const librevenge::RVNGString &text)
 
 void STOFFGraphicEncoder::insertLineBreak()
 {
-  m_state->m_encoder.insertElement("InsertLineBreak");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertLineBreak);
 }
 
 void STOFFGraphicEncoder::insertField(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertField", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertField, list);
 }
 
 void STOFFGraphicEncoder::openLink(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenLink", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenLink, list);
 }
 
 void STOFFGraphicEncoder::closeLink()
 {
-  m_state->m_encoder.insertElement("CloseLink");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseLink);
 }
 
 void STOFFGraphicEncoder::openOrderedListLevel(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenOrderedListLevel", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenOrderedListLevel, list);
 }
 
 void STOFFGraphicEncoder::openUnorderedListLevel(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenUnorderedListLevel", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenUnorderedListLevel, list);
 }
 
 void STOFFGraphicEncoder::closeOrderedListLevel()
 {
-  m_state->m_encoder.insertElement("CloseOrderedListLevel");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseOrderedListLevel);
 }
 
 void STOFFGraphicEncoder::closeUnorderedListLevel()
 {
-  m_state->m_encoder.insertElement("CloseOrderedListLevel");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseOrderedListLevel);
 }
 
 void STOFFGraphicEncoder::openListElement(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenListElement", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenListElement, list);
 }
 
 void STOFFGraphicEncoder::closeListElement()
 {
-  m_state->m_encoder.insertElement("CloseListElement");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseListElement);
 }
 
 void STOFFGraphicEncoder::defineParagraphStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineParagraphStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineParagraphStyle, list);
 }
 
 void STOFFGraphicEncoder::openParagraph(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenParagraph", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenParagraph, list);
 }
 
 void STOFFGraphicEncoder::closeParagraph()
 {
-  m_state->m_encoder.insertElement("CloseParagraph");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseParagraph);
 }
 
 void STOFFGraphicEncoder::defineCharacterStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineCharacterStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineCharacterStyle, list);
 }
 
 void STOFFGraphicEncoder::openSpan(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenSpan", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenSpan, list);
 }
 
 void STOFFGraphicEncoder::closeSpan()
 {
-  m_state->m_encoder.insertElement("CloseSpan");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseSpan);
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
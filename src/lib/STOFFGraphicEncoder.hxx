@@ -55,8 +55,11 @@ struct State;
 class STOFFGraphicEncoder final : public librevenge::RVNGDrawingInterface
 {
 public:
-  /// constructor
-  STOFFGraphicEncoder();
+  /** constructor
+
+      \param recordCalls if set, the calls are also stored in memory and attached to the object
+      returned by getBinaryResult, so that STOFFDocument::decodeGraphic can replay them directly */
+  explicit STOFFGraphicEncoder(bool recordCalls=false);
   /// destructor
   ~STOFFGraphicEncoder() final;
   /// return the final graphic
@@ -138,6 +138,8 @@ struct State {
   STOFFVec2f m_origin;
   //! a buffer to stored the text
   librevenge::RVNGString m_textBuffer;
+  //! true if the text buffer can contain some consecutive spaces
+  bool m_textBufferHasConsecutiveSpaces;
 
   //! the font
   STOFFFont m_font;
@@ -187,6 +189,7 @@ private:
 State::State()
   : m_origin(0,0)
   , m_textBuffer("")
+  , m_textBufferHasConsecutiveSpaces(false)
   , m_font()/* default time 12 */
   , m_paragraph()
   , m_list()
@@ -303,6 +306,8 @@ void STOFFGraphicListener::insertChar(uint8_t character)
     return;
   }
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (character==' ' && libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, " "))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   m_ps->m_textBuffer.append(char(character));
 }
 
@@ -322,9 +327,23 @@ void STOFFGraphicListener::insertUnicode(uint32_t val)
     return;
   }
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (val==0x20 && libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, " "))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   libstoff::appendUnicode(val, m_ps->m_textBuffer);
 }
 
+void STOFFGraphicListener::insertUnicodeRun(uint32_t const *chars, size_t numChars)
+{
+  if (!m_ps->isInTextZone()) {
+    STOFF_DEBUG_MSG(("STOFFGraphicListener::insertUnicodeRun: called outside a text zone\n"));
+    return;
+  }
+  if (!chars || !numChars) return;
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  if (libstoff::appendUnicodeRun(chars, numChars, m_ps->m_textBuffer))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
+}
+
 void STOFFGraphicListener::insertUnicodeString(librevenge::RVNGString const &str)
 {
   if (!m_ps->isInTextZone()) {
@@ -332,6 +351,8 @@ void STOFFGraphicListener::insertUnicodeString(librevenge::RVNGString const &str
     return;
   }
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, str.cstr()))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   m_ps->m_textBuffer.append(str);
 }
 
@@ -579,6 +600,7 @@ void STOFFGraphicListener::_openPageSpan(bool sendHeaderFooters)
 {
   if (m_ds->m_isPageSpanOpened)
     return;
+  updateParseControl();
 
   if (!m_ds->m_isDocumentStarted)
     startDocument();
@@ -921,6 +943,15 @@ void STOFFGraphicListener::_flushText()
 {
   if (m_ps->m_textBuffer.len() == 0) return;
 
+  if (!m_ps->m_textBufferHasConsecutiveSpaces) {
+    if (m_drawingInterface)
+      m_drawingInterface->insertText(m_ps->m_textBuffer);
+    else
+      m_presentationInterface->insertText(m_ps->m_textBuffer);
+    m_ps->m_textBuffer.clear();
+    return;
+  }
+
   // when some many ' ' follows each other, call insertSpace
   librevenge::RVNGString tmpText("");
   int numConsecutiveSpaces = 0;
@@ -952,6 +983,7 @@ void STOFFGraphicListener::_flushText()
   else
     m_presentationInterface->insertText(tmpText);
   m_ps->m_textBuffer.clear();
+  m_ps->m_textBufferHasConsecutiveSpaces=false;
 }
 
 ///////////////////
@@ -36,6 +36,7 @@
 #include <limits>
 #include <cmath>
 #include <cstring>
+#include <mutex>
 
 #include <librevenge-stream/librevenge-stream.h>
 #include <librevenge/librevenge.h>
@@ -44,10 +45,24 @@
 
 #include "STOFFInputStream.hxx"
 
+//! Internal: namespace used to define some STOFFInputStream functions
+namespace STOFFInputStreamInternal
+{
+//! returns the mutex used to protect the creation of the sub streams, which moves the structured stream cursor
+static std::mutex &getSubStreamMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+}
+
 STOFFInputStream::STOFFInputStream(std::shared_ptr<librevenge::RVNGInputStream> inp, bool inverted)
   : m_stream(inp)
   , m_streamSize(0)
   , m_inverseRead(inverted)
+  , m_skipBinaryData(false)
+  , m_recordEmbeddedObjects(false)
+  , m_parseControl()
 {
   updateStreamSize();
 }
@@ -56,6 +71,9 @@ STOFFInputStream::STOFFInputStream(librevenge::RVNGInputStream *inp, bool invert
   : m_stream()
   , m_streamSize(0)
   , m_inverseRead(inverted)
+  , m_skipBinaryData(false)
+  , m_recordEmbeddedObjects(false)
+  , m_parseControl()
 {
   if (!inp) return;
 
@@ -531,6 +549,8 @@ std::shared_ptr<STOFFInputStream> STOFFInputStream::getSubStreamByName(std::stri
     return empty;
   }
 
+  // the embedded objects can be decoded concurrently, see StarFileManager::decodeOLEDirectories
+  std::lock_guard<std::mutex> lock(STOFFInputStreamInternal::getSubStreamMutex());
   long actPos = tell();
   seek(0, librevenge::RVNG_SEEK_SET);
   std::shared_ptr<librevenge::RVNGInputStream> res(m_stream->getSubStreamByName(name.c_str()));
@@ -539,6 +559,9 @@ std::shared_ptr<STOFFInputStream> STOFFInputStream::getSubStreamByName(std::stri
   if (!res)
     return empty;
   std::shared_ptr<STOFFInputStream> inp(new STOFFInputStream(res,m_inverseRead));
+  inp->setSkipBinaryData(m_skipBinaryData);
+  inp->setRecordEmbeddedObjects(m_recordEmbeddedObjects);
+  inp->setParseControl(m_parseControl);
   inp->seek(0, librevenge::RVNG_SEEK_SET);
   return inp;
 }
@@ -551,6 +574,8 @@ std::shared_ptr<STOFFInputStream> STOFFInputStream::getSubStreamById(unsigned id
     return empty;
   }
 
+  // the embedded objects can be decoded concurrently, see StarFileManager::decodeOLEDirectories
+  std::lock_guard<std::mutex> lock(STOFFInputStreamInternal::getSubStreamMutex());
   long actPos = tell();
   seek(0, librevenge::RVNG_SEEK_SET);
   std::shared_ptr<librevenge::RVNGInputStream> res(m_stream->getSubStreamById(id));
@@ -559,6 +584,9 @@ std::shared_ptr<STOFFInputStream> STOFFInputStream::getSubStreamById(unsigned id
   if (!res)
     return empty;
   std::shared_ptr<STOFFInputStream> inp(new STOFFInputStream(res,m_inverseRead));
+  inp->setSkipBinaryData(m_skipBinaryData);
+  inp->setRecordEmbeddedObjects(m_recordEmbeddedObjects);
+  inp->setParseControl(m_parseControl);
   inp->seek(0, librevenge::RVNG_SEEK_SET);
   return inp;
 }
@@ -578,6 +606,8 @@ bool STOFFInputStream::readDataBlock(long sz, librevenge::RVNGBinaryData &data)
   if (sz == 0) return true;
   long endPos=tell()+sz;
   if (endPos > size()) return false;
+  if (m_skipBinaryData)
+    return seek(endPos, librevenge::RVNG_SEEK_SET)==0;
 
   const unsigned char *readData;
   unsigned long sizeRead;
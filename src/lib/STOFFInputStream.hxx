@@ -41,6 +41,7 @@
 #include <librevenge-stream/librevenge-stream.h>
 #include "libstaroffice_internal.hxx"
 
+class STOFFParseControl;
 /*! \class STOFFInputStream
  * \brief Internal class used to read the file stream
  *  Internal class used to read the file stream,
@@ -85,6 +86,36 @@ public:
   {
     m_inverseRead = newVal;
   }
+  //! returns true if the binary data (pictures, ...) must not be decoded
+  bool skipBinaryData() const
+  {
+    return m_skipBinaryData;
+  }
+  //! sets the binary data mode (this mode is inherited by the sub streams)
+  void setSkipBinaryData(bool skip)
+  {
+    m_skipBinaryData = skip;
+  }
+  //! returns true if the embedded objects' calls must be recorded
+  bool recordEmbeddedObjects() const
+  {
+    return m_recordEmbeddedObjects;
+  }
+  //! sets the flag to record the embedded objects' calls (this flag is inherited by the sub streams)
+  void setRecordEmbeddedObjects(bool record)
+  {
+    m_recordEmbeddedObjects = record;
+  }
+  //! returns the object used to follow/cancel the parsing (if any)
+  std::shared_ptr<STOFFParseControl> getParseControl() const
+  {
+    return m_parseControl;
+  }
+  //! sets the object used to follow/cancel the parsing (this object is inherited by the sub streams)
+  void setParseControl(std::shared_ptr<STOFFParseControl> control)
+  {
+    m_parseControl = control;
+  }
   //
   // Position: access
   //
@@ -197,7 +228,9 @@ public:
    */
   static unsigned long readULong(librevenge::RVNGInputStream *stream, int num, unsigned long a, bool inverseRead);
 
-  //! reads a librevenge::RVNGBinaryData with a given size in the actual section/file
+  /** reads a librevenge::RVNGBinaryData with a given size in the actual section/file
+
+      \note if skipBinaryData is set, only moves the position and returns an empty data */
   bool readDataBlock(long size, librevenge::RVNGBinaryData &data);
   //! reads a librevenge::RVNGBinaryData from actPos to the end of the section/file
   bool readEndDataBlock(librevenge::RVNGBinaryData &data);
@@ -246,6 +279,12 @@ protected:
 
   //! big or normal endian
   bool m_inverseRead;
+  //! a flag to know if we must skip the binary data
+  bool m_skipBinaryData;
+  //! a flag to know if we must record the embedded objects' calls
+  bool m_recordEmbeddedObjects;
+  //! the object used to follow/cancel the parsing
+  std::shared_ptr<STOFFParseControl> m_parseControl;
 };
 
 #endif
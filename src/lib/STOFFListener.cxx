@@ -37,9 +37,11 @@
 #include "STOFFListener.hxx"
 
 #include "STOFFList.hxx"
+#include "STOFFParseControl.hxx"
 
 STOFFListener::STOFFListener(STOFFListManagerPtr &listManager)
   : m_listManager(listManager)
+  , m_parseControl()
 {
   if (!m_listManager)
     m_listManager.reset(new STOFFListManager);
@@ -49,4 +51,14 @@ STOFFListener::~STOFFListener()
 {
 }
 
+void STOFFListener::updateParseControl()
+{
+  if (!m_parseControl) return;
+  if (m_parseControl->isCancelled()) {
+    STOFF_DEBUG_MSG(("STOFFListener::updateParseControl: the parsing is cancelled\n"));
+    throw libstoff::ParseException();
+  }
+  m_parseControl->addPageSent();
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -44,6 +44,7 @@
 #include "STOFFPosition.hxx"
 
 class STOFFCell;
+class STOFFParseControl;
 class STOFFTable;
 
 /** This class contains a virtual interface to all listener */
@@ -68,6 +69,11 @@ public:
   {
     return m_listManager;
   }
+  //! sets the object used to follow/cancel the parsing
+  void setParseControl(std::shared_ptr<STOFFParseControl> control)
+  {
+    m_parseControl=control;
+  }
   // ------ main document -------
   /** sets the documents language */
   virtual void setDocumentLanguage(std::string locale) = 0;
@@ -110,16 +116,24 @@ public:
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   virtual void insertUnicode(uint32_t character)=0;
+  /** adds a run of unicode characters: similar to calling insertUnicode
+      for each character but faster */
+  virtual void insertUnicodeRun(uint32_t const *chars, size_t numChars)=0;
   /** try to insert a list of unicode character */
   void insertUnicodeList(std::vector<uint32_t> const &list)
   {
     if (list.empty() || !canWriteText())
       return;
-    for (unsigned int i : list) {
+    size_t first=0;
+    for (size_t c=0; c<list.size(); ++c) {
+      uint32_t i=list[c];
+      if (i!=0x9 && i!=0xa && i!=0xc) continue;
+      if (c>first) insertUnicodeRun(&list[first], c-first);
+      first=c+1;
       if (i==0x9) insertTab();
-      else if (i==0xa || i==0xc) insertEOL(); // checkme: use softBreak ?
-      else insertUnicode(i);
+      else insertEOL(); // checkme: use softBreak ?
     }
+    if (list.size()>first) insertUnicodeRun(&list[first], list.size()-first);
   }
   //! adds a unicode string
   virtual void insertUnicodeString(librevenge::RVNGString const &str)=0;
@@ -246,8 +260,14 @@ public:
 protected:
   /// constructor
   explicit STOFFListener(STOFFListManagerPtr &listManager);
+  /** signals to the parse control (if any) that a new page/sheet is sent
+
+   \note throws a libstoff::ParseException if the parsing is cancelled */
+  void updateParseControl();
   /// the list manager
   STOFFListManagerPtr m_listManager;
+  /// the object used to follow/cancel the parsing
+  std::shared_ptr<STOFFParseControl> m_parseControl;
 };
 
 #endif
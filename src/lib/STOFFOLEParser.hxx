@@ -80,6 +80,8 @@ namespace STOFFOLEParserInternal
 struct State;
 }
 
+class StarObject;
+
 /** \brief a class used to parse some basic oles
     Tries to read the different ole parts and stores their contents in form of picture.
  */
@@ -193,7 +195,12 @@ public:
       , m_clsName("")
       , m_clipName("")
       , m_parsed(false)
-      , m_inUse(false) { }
+      , m_inUse(false)
+      , m_referenced(false)
+      , m_decoded(false)
+      , m_decodedOk(false)
+      , m_decodedImage()
+      , m_decodedObject() { }
     //! add a new base file
     void addNewBase(std::string const &base)
     {
@@ -230,6 +237,16 @@ public:
     bool m_parsed;
     /** a flag to know if the directory is currently used */
     mutable bool m_inUse;
+    /** a flag to know if the directory is referenced by an object of the document */
+    bool m_referenced;
+    /** a flag to know if the directory has already been decoded, see StarFileManager::decodeOLEDirectories */
+    bool m_decoded;
+    /** the result of the decoding */
+    bool m_decodedOk;
+    /** the decoded image */
+    STOFFEmbeddedObject m_decodedImage;
+    /** the decoded object */
+    std::shared_ptr<StarObject> m_decodedObject;
   };
 
 protected:
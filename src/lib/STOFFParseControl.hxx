@@ -0,0 +1,106 @@
+/* -*- Mode: C++; c-default-style: "k&r"; indent-tabs-mode: nil; tab-width: 2; c-basic-offset: 2 -*- */
+
+/* libstaroffice
+* Version: MPL 2.0 / LGPLv2+
+*
+* The contents of this file are subject to the Mozilla Public License Version
+* 2.0 (the "License"); you may not use this file except in compliance with
+* the License or as specified alternatively below. You may obtain a copy of
+* the License at http://www.mozilla.org/MPL/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* Major Contributor(s):
+* Copyright (C) 2002 William Lachance (wrlach@gmail.com)
+* Copyright (C) 2002,2004 Marc Maurer (uwog@uwog.net)
+* Copyright (C) 2004-2006 Fridrich Strba (fridrich.strba@bluewin.ch)
+* Copyright (C) 2006, 2007 Andrew Ziem
+* Copyright (C) 2011, 2012 Alonso Laurent (alonso@loria.fr)
+*
+*
+* All Rights Reserved.
+*
+* For minor contributions see the git repository.
+*
+* Alternatively, the contents of this file may be used under the terms of
+* the GNU Lesser General Public License Version 2 or later (the "LGPLv2+"),
+* in which case the provisions of the LGPLv2+ are applicable
+* instead of those above.
+*/
+
+#ifndef STOFF_PARSE_CONTROL
+#  define STOFF_PARSE_CONTROL
+
+#include <atomic>
+
+/** \brief a small class used to follow and to stop an asynchronous parsing
+ *
+ * This object is shared by the input streams (which pass it to their sub streams),
+ * the StarZone record functions and the listeners: the zones update the number of
+ * bytes read, the listeners the number of pages/sheets sent; both throw a
+ * libstoff::ParseException when the parsing has been cancelled.
+ */
+class STOFFParseControl
+{
+public:
+  //! constructor
+  STOFFParseControl()
+    : m_cancelled(false)
+    , m_numBytesRead(0)
+    , m_numBytesTotal(0)
+    , m_numPagesSent(0)
+  {
+  }
+  //! asks to stop the parsing as soon as possible
+  void cancel()
+  {
+    m_cancelled=true;
+  }
+  //! returns true if the parsing has been cancelled
+  bool isCancelled() const
+  {
+    return m_cancelled;
+  }
+  //! sets the main stream size
+  void setNumBytesTotal(long numBytes)
+  {
+    m_numBytesTotal=numBytes;
+  }
+  //! adds some bytes to the number of bytes read
+  void addNumBytesRead(long numBytes)
+  {
+    m_numBytesRead+=numBytes;
+  }
+  //! increases the number of pages/sheets sent
+  void addPageSent()
+  {
+    ++m_numPagesSent;
+  }
+  /** returns the current progress
+
+   \note the bytes are counted in the different sub streams, so the number of bytes read is bounded by the main stream size */
+  void getProgress(long &numBytesRead, long &numBytesTotal, int &numPagesSent) const
+  {
+    numBytesTotal=m_numBytesTotal;
+    numBytesRead=m_numBytesRead;
+    if (numBytesRead>numBytesTotal) numBytesRead=numBytesTotal;
+    numPagesSent=m_numPagesSent;
+  }
+protected:
+  //! a flag to know if the parsing must be stopped
+  std::atomic<bool> m_cancelled;
+  //! the number of bytes read
+  std::atomic<long> m_numBytesRead;
+  //! the main stream size
+  std::atomic<long> m_numBytesTotal;
+  //! the number of pages/sheets sent
+  std::atomic<int> m_numPagesSent;
+private:
+  STOFFParseControl(STOFFParseControl const &orig) = delete;
+  STOFFParseControl &operator=(STOFFParseControl const &orig) = delete;
+};
+#endif
+// vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -47,6 +47,9 @@ STOFFParserState::STOFFParserState(STOFFParserState::Type type, STOFFInputStream
   , m_input(input)
   , m_header(header)
   , m_pageSpan()
+  , m_pageRange(0,-1)
+  , m_cellWindowSheet(-1)
+  , m_cellWindow()
   , m_listManager()
   , m_graphicListener()
   , m_spreadsheetListener()
@@ -78,6 +81,8 @@ STOFFParser::~STOFFParser()
 void STOFFParser::setGraphicListener(STOFFGraphicListenerPtr &listener)
 {
   m_parserState->m_graphicListener=listener;
+  if (listener && getInput())
+    listener->setParseControl(getInput()->getParseControl());
 }
 
 void STOFFParser::resetGraphicListener()
@@ -89,6 +94,8 @@ void STOFFParser::resetGraphicListener()
 void STOFFParser::setSpreadsheetListener(STOFFSpreadsheetListenerPtr &listener)
 {
   m_parserState->m_spreadsheetListener=listener;
+  if (listener && getInput())
+    listener->setParseControl(getInput()->getParseControl());
 }
 
 void STOFFParser::resetSpreadsheetListener()
@@ -100,6 +107,8 @@ void STOFFParser::resetSpreadsheetListener()
 void STOFFParser::setTextListener(STOFFTextListenerPtr &listener)
 {
   m_parserState->m_textListener=listener;
+  if (listener && getInput())
+    listener->setParseControl(getInput()->getParseControl());
 }
 
 void STOFFParser::resetTextListener()
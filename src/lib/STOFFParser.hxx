@@ -67,6 +67,16 @@ public:
   STOFFHeader *m_header;
   //! the actual document size
   STOFFPageSpan m_pageSpan;
+  /** the range of pages to send: 0-based, the last page is included, a negative last page means all the following pages
+
+   \note only used by the draw and the presentation parsers */
+  STOFFVec2i m_pageRange;
+  /** the sheet whose cells are sent (0-based), a negative value means all the sheets
+
+   \note only used by the spreadsheet parsers */
+  int m_cellWindowSheet;
+  //! the window of cells to send in m_cellWindowSheet: 0-based, the last column and row are included
+  STOFFBox2i m_cellWindow;
 
   //! the list manager
   STOFFListManagerPtr m_listManager;
@@ -124,6 +134,17 @@ public:
   {
     return m_parserState->m_pageSpan;
   }
+  //! sets the range of pages to send, see STOFFParserState::m_pageRange
+  void setPageRange(STOFFVec2i const &range)
+  {
+    m_parserState->m_pageRange = range;
+  }
+  //! sets the sheet and the window of cells to send, see STOFFParserState::m_cellWindow
+  void setCellWindow(int sheet, STOFFBox2i const &window)
+  {
+    m_parserState->m_cellWindowSheet = sheet;
+    m_parserState->m_cellWindow = window;
+  }
   //! returns the graphic listener
   STOFFGraphicListenerPtr &getGraphicListener()
   {
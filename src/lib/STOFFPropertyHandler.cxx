@@ -37,6 +37,9 @@
 #include <sstream>
 #include <string.h>
 
+#include <deque>
+#include <map>
+#include <memory>
 #include <stack>
 
 #include "libstaroffice_internal.hxx"
@@ -47,49 +50,126 @@
 
 #include "STOFFPropertyHandler.hxx"
 
+/** Internal: the structures of a STOFFPropertyHandler */
+namespace STOFFPropertyHandlerInternal
+{
+//! the compact format header
+static char const s_header[]= {'\0', 'S', 'T', 'O', 'F', 'F'};
+//! the compact format version
+static unsigned char const s_version=1;
+//! the tag names
+static char const *s_tagNames[]= {
+    "", "CloseChart", "CloseChartPlotArea", "CloseChartSerie", "CloseChartTextObject",
+    "CloseComment", "CloseFooter", "CloseFootnote", "CloseFrame", "CloseGroup", "CloseHeader",
+    "CloseLink", "CloseListElement", "CloseOrderedListLevel", "ClosePageSpan", "CloseParagraph",
+    "CloseSection", "CloseSheet", "CloseSheetCell", "CloseSheetRow", "CloseSpan", "CloseTable",
+    "CloseTableCell", "CloseTableRow", "CloseTextBox", "CloseUnorderedListLevel",
+    "DefineCharacterStyle", "DefineChartStyle", "DefineEmbeddedFont", "DefineGraphicStyle",
+    "DefinePageStyle", "DefineParagraphStyle", "DefineSectionStyle", "DefineSheetNumberingStyle",
+    "DrawConnector", "DrawEllipse", "DrawGraphicObject", "DrawPath", "DrawPolygon", "DrawPolyline",
+    "DrawRectangle", "EndDocument", "EndEmbeddedGraphics", "EndLayer", "EndMasterPage", "EndPage",
+    "EndTableObject", "EndTextObject", "InsertBinaryObject", "InsertChartAxis",
+    "InsertCoveredTableCell", "InsertEquation", "InsertField", "InsertLineBreak", "InsertSpace",
+    "InsertTab", "OpenChart", "OpenChartPlotArea", "OpenChartSerie", "OpenChartTextObject",
+    "OpenComment", "OpenFooter", "OpenFootnote", "OpenFrame", "OpenGroup", "OpenHeader", "OpenLink",
+    "OpenListElement", "OpenOrderedListLevel", "OpenPageSpan", "OpenParagraph", "OpenSection",
+    "OpenSheet", "OpenSheetCell", "OpenSheetRow", "OpenSpan", "OpenTable", "OpenTableCell",
+    "OpenTableRow", "OpenTextBox", "OpenUnorderedListLevel", "SetDocumentMetaData", "SetStyle",
+    "StartDocument", "StartEmbeddedGraphics", "StartLayer", "StartMasterPage", "StartPage",
+    "StartTableObject", "StartTextObject"
+};
+}
+
 ////////////////////////////////////////////////////
 //
 // STOFFPropertyHandlerEncoder
 //
 ////////////////////////////////////////////////////
 STOFFPropertyHandlerEncoder::STOFFPropertyHandlerEncoder()
-  : m_f(std::ios::in | std::ios::out | std::ios::binary)
+  : m_data()
+  , m_keyToIdMap()
+  , m_callList()
 {
+  m_data.append(STOFFPropertyHandlerInternal::s_header, sizeof(STOFFPropertyHandlerInternal::s_header));
+  m_data+=char(STOFFPropertyHandlerInternal::s_version);
 }
 
-void STOFFPropertyHandlerEncoder::insertElement(const char *psName)
+void STOFFPropertyHandlerEncoder::insertElement(STOFFPropertyHandler::Tag tag)
 {
-  m_f << 'E';
-  writeString(psName);
+  if (m_callList) {
+    librevenge::RVNGPropertyList call;
+    call.insert("librevenge:stoff-tag", int(tag));
+    m_callList->append(call);
+  }
+  m_data+='e';
+  writeULong(static_cast<unsigned long>(tag));
 }
 
 void STOFFPropertyHandlerEncoder::insertElement
-(const char *psName, const librevenge::RVNGPropertyList &xPropList)
+(STOFFPropertyHandler::Tag tag, const librevenge::RVNGPropertyList &xPropList)
 {
-  m_f << 'S';
-  writeString(psName);
+  if (m_callList) {
+    librevenge::RVNGPropertyList call;
+    call.insert("librevenge:stoff-tag", int(tag));
+    librevenge::RVNGPropertyListVector properties;
+    properties.append(xPropList);
+    call.insert("librevenge:stoff-properties", properties);
+    m_callList->append(call);
+  }
+  m_data+='s';
+  writeULong(static_cast<unsigned long>(tag));
   writePropertyList(xPropList);
 }
 
 void STOFFPropertyHandlerEncoder::characters(librevenge::RVNGString const &sCharacters)
 {
   if (sCharacters.len()==0) return;
-  m_f << 'T';
-  writeString(sCharacters);
+  if (m_callList) {
+    librevenge::RVNGPropertyList call;
+    call.insert("librevenge:stoff-tag", int(STOFFPropertyHandler::T_Unknown));
+    call.insert("librevenge:stoff-characters", sCharacters);
+    m_callList->append(call);
+  }
+  m_data+='t';
+  writeString(sCharacters.cstr(), sCharacters.size());
+}
+
+void STOFFPropertyHandlerEncoder::writeULong(unsigned long val)
+{
+  while (val>=0x80) {
+    m_data+=char((val&0x7f)|0x80);
+    val>>=7;
+  }
+  m_data+=char(val);
+}
+
+void STOFFPropertyHandlerEncoder::writeString(char const *str, unsigned long len)
+{
+  writeULong(len);
+  if (len) m_data.append(str, size_t(len));
 }
 
-void STOFFPropertyHandlerEncoder::writeString(const librevenge::RVNGString &string)
+void STOFFPropertyHandlerEncoder::writeKey(char const *key)
 {
-  unsigned long sz = string.size()+1;
-  writeLong(long(sz));
-  m_f.write(string.cstr(), int(sz));
+  auto it=m_keyToIdMap.find(key);
+  if (it!=m_keyToIdMap.end()) {
+    writeULong(it->second);
+    return;
+  }
+  auto id=static_cast<unsigned long>(m_keyToIdMap.size()+1);
+  m_keyToIdMap[key]=id;
+  writeULong(0);
+  writeString(key, static_cast<unsigned long>(strlen(key)));
 }
 
-void STOFFPropertyHandlerEncoder::writeLong(long val)
+void STOFFPropertyHandlerEncoder::writeDouble(double val, librevenge::RVNGUnit unit)
 {
-  auto value=static_cast<int32_t>(val);
-  unsigned char const allValue[]= {static_cast<unsigned char>(value&0xFF), static_cast<unsigned char>((value>>8)&0xFF), static_cast<unsigned char>((value>>16)&0xFF), static_cast<unsigned char>((value>>24)&0xFF)};
-  m_f.write(reinterpret_cast<const char *>(allValue), 4);
+  m_data+='d';
+  m_data+=char(unit);
+  uint64_t bits;
+  memcpy(&bits, &val, 8);
+  for (int i=0; i<8; ++i, bits>>=8)
+    m_data+=char(bits&0xFF);
 }
 
 void STOFFPropertyHandlerEncoder::writeProperty(const char *key, const librevenge::RVNGProperty &prop)
@@ -98,32 +178,59 @@ void STOFFPropertyHandlerEncoder::writeProperty(const char *key, const libreveng
     STOFF_DEBUG_MSG(("STOFFPropertyHandlerEncoder::writeProperty: key is NULL\n"));
     return;
   }
-  writeString(key);
-  writeString(prop.getStr());
+  writeKey(key);
+  auto const unit=prop.getUnit();
+  if (unit==librevenge::RVNG_INCH || unit==librevenge::RVNG_PERCENT || unit==librevenge::RVNG_POINT || unit==librevenge::RVNG_TWIP) {
+    writeDouble(prop.getDouble(), unit);
+    return;
+  }
+  auto const str=prop.getStr();
+  if (unit==librevenge::RVNG_GENERIC) {
+    // an int, a bool or a double: check that the decoded property will give the same string
+    if (str=="true" || str=="false") {
+      m_data+=(str=="true") ? 'B' : 'b';
+      return;
+    }
+    int const iVal=prop.getInt();
+    librevenge::RVNGString iStr;
+    iStr.sprintf("%i", iVal);
+    if (str==iStr) {
+      m_data+='i';
+      writeULong(iVal>=0 ? 2*static_cast<unsigned long>(iVal) : 2*static_cast<unsigned long>(-(iVal+1))+1);
+      return;
+    }
+    double const val=prop.getDouble();
+    std::unique_ptr<librevenge::RVNGProperty> dProp(librevenge::RVNGPropertyFactory::newDoubleProp(val));
+    if (dProp && dProp->getStr()==str) {
+      writeDouble(val, unit);
+      return;
+    }
+  }
+  m_data+='s';
+  writeString(str.cstr(), str.size());
 }
 
 void STOFFPropertyHandlerEncoder::writePropertyList(const librevenge::RVNGPropertyList &xPropList)
 {
   librevenge::RVNGPropertyList::Iter i(xPropList);
-  long numElt = 0;
+  unsigned long numElt = 0;
   for (i.rewind(); i.next();) numElt++;
-  writeLong(numElt);
+  writeULong(numElt);
   for (i.rewind(); i.next();) {
     auto const *child=xPropList.child(i.key());
     if (!child) {
-      m_f << 'p';
       writeProperty(i.key(),*i());
       continue;
     }
-    m_f << 'v';
-    writeString(i.key());
+    writeKey(i.key());
+    m_data+='v';
     writePropertyListVector(*child);
   }
 }
 
 void STOFFPropertyHandlerEncoder::writePropertyListVector(const librevenge::RVNGPropertyListVector &vect)
 {
-  writeLong(long(vect.count()));
+  writeULong(vect.count());
   for (unsigned long i=0; i < vect.count(); i++)
     writePropertyList(vect[i]);
 }
@@ -131,9 +238,8 @@ void STOFFPropertyHandlerEncoder::writePropertyListVector(const librevenge::RVNG
 bool STOFFPropertyHandlerEncoder::getData(librevenge::RVNGBinaryData &data)
 {
   data.clear();
-  std::string d=m_f.str();
-  if (d.length() == 0) return false;
-  data.append(reinterpret_cast<const unsigned char *>(d.c_str()), d.length());
+  if (m_data.length() <= sizeof(STOFFPropertyHandlerInternal::s_header)+1) return false;
+  data.append(reinterpret_cast<const unsigned char *>(m_data.c_str()), m_data.length());
   return true;
 }
 
@@ -145,10 +251,218 @@ class STOFFPropertyHandlerDecoder
 {
 public:
   //! constructor given a STOFFPropertyHandler
-  explicit STOFFPropertyHandlerDecoder(STOFFPropertyHandler *hdl=nullptr):m_handler(hdl) {}
+  explicit STOFFPropertyHandlerDecoder(STOFFPropertyHandler *hdl=nullptr)
+    : m_handler(hdl)
+    , m_pos(nullptr)
+    , m_end(nullptr)
+    , m_keyList()
+  {
+  }
 
   //! tries to read the data
   bool readData(librevenge::RVNGBinaryData const &encoded)
+  {
+    unsigned long const headerSize=sizeof(STOFFPropertyHandlerInternal::s_header);
+    auto const *buffer=encoded.getDataBuffer();
+    if (!buffer || encoded.size()==0) return false;
+    if (buffer[0]!=0) // created by libstaroffice 0.0.6 or older
+      return readLegacyData(encoded);
+    if (encoded.size()<=headerSize || memcmp(buffer, STOFFPropertyHandlerInternal::s_header, headerSize)!=0) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readData: can not find the header\n"));
+      return false;
+    }
+    if (buffer[headerSize]!=STOFFPropertyHandlerInternal::s_version) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readData: unknown version %d\n", int(buffer[headerSize])));
+      return false;
+    }
+    m_pos=buffer+headerSize+1;
+    m_end=buffer+encoded.size();
+    m_keyList.clear();
+    try {
+      while (m_pos<m_end) {
+        unsigned char c=*(m_pos++);
+        switch (c) {
+        case 'e': {
+          STOFFPropertyHandler::Tag tag;
+          if (!readTag(tag)) return false;
+          if (m_handler) m_handler->insertElement(tag);
+          break;
+        }
+        case 's': {
+          STOFFPropertyHandler::Tag tag;
+          librevenge::RVNGPropertyList lists;
+          if (!readTag(tag) || !readPropertyList(lists)) {
+            STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readData: can not read an element with properties\n"));
+            return false;
+          }
+          if (m_handler) m_handler->insertElement(tag, lists);
+          break;
+        }
+        case 't': {
+          librevenge::RVNGString s;
+          if (!readString(s)) return false;
+          if (m_handler && !s.empty()) m_handler->characters(s);
+          break;
+        }
+        default:
+          STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readData: unknown type='%c' \n", char(c)));
+          return false;
+        }
+      }
+    }
+    catch (...) {
+      return false;
+    }
+    return true;
+  }
+
+protected:
+  //
+  // compact format
+  //
+
+  //! reads an unsigned value
+  bool readULong(unsigned long &val)
+  {
+    val=0;
+    for (int depth=0; depth<64; depth+=7) {
+      if (m_pos>=m_end) {
+        STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readULong: can not read a value\n"));
+        return false;
+      }
+      unsigned char c=*(m_pos++);
+      val|=static_cast<unsigned long>(c&0x7f)<<depth;
+      if ((c&0x80)==0)
+        return true;
+    }
+    STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readULong: the value is too big\n"));
+    return false;
+  }
+  //! reads a tag
+  bool readTag(STOFFPropertyHandler::Tag &tag)
+  {
+    unsigned long val;
+    if (!readULong(val)) return false;
+    if (val==0 || val>=static_cast<unsigned long>(STOFFPropertyHandler::T_MaxTag)) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readTag: unknown tag %lu\n", val));
+      return false;
+    }
+    tag=static_cast<STOFFPropertyHandler::Tag>(val);
+    return true;
+  }
+  //! reads a string: size and characters
+  bool readString(librevenge::RVNGString &s)
+  {
+    std::string str;
+    if (!readString(str)) return false;
+    s=librevenge::RVNGString(str.c_str());
+    return true;
+  }
+  //! reads a string: size and characters
+  bool readString(std::string &s)
+  {
+    unsigned long len;
+    if (!readULong(len)) return false;
+    if (len>static_cast<unsigned long>(m_end-m_pos)) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readString: the string length seems bad\n"));
+      return false;
+    }
+    s.assign(reinterpret_cast<char const *>(m_pos), size_t(len));
+    m_pos+=len;
+    return true;
+  }
+  //! reads a key
+  bool readKey(std::string const *&key)
+  {
+    unsigned long id;
+    if (!readULong(id)) return false;
+    if (id==0) {
+      std::string newKey;
+      if (!readString(newKey) || newKey.empty()) {
+        STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readKey: can not read a new key\n"));
+        return false;
+      }
+      m_keyList.push_back(newKey);
+      key=&m_keyList.back();
+      return true;
+    }
+    if (id>m_keyList.size()) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readKey: unknown key %lu\n", id));
+      return false;
+    }
+    key=&m_keyList[size_t(id-1)];
+    return true;
+  }
+  //! reads a property list: number of properties followed by list of properties
+  bool readPropertyList(librevenge::RVNGPropertyList &list)
+  {
+    unsigned long numElt;
+    if (!readULong(numElt)) return false;
+    for (unsigned long i=0; i<numElt; ++i) {
+      std::string const *key=nullptr;
+      if (!readKey(key) || m_pos>=m_end) return false;
+      unsigned char type=*(m_pos++);
+      switch (type) {
+      case 's': {
+        librevenge::RVNGString val;
+        if (!readString(val)) return false;
+        list.insert(key->c_str(), val);
+        break;
+      }
+      case 'i': {
+        unsigned long val;
+        if (!readULong(val)) return false;
+        list.insert(key->c_str(), (val&1) ? -int(val>>1)-1 : int(val>>1));
+        break;
+      }
+      case 'b':
+      case 'B':
+        list.insert(key->c_str(), type=='B');
+        break;
+      case 'd': {
+        if (m_end-m_pos<9) {
+          STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readPropertyList: can not read a double\n"));
+          return false;
+        }
+        auto unit=static_cast<librevenge::RVNGUnit>(*(m_pos++));
+        uint64_t bits=0;
+        for (int b=7; b>=0; --b)
+          bits=(bits<<8)|m_pos[b];
+        m_pos+=8;
+        double val;
+        memcpy(&val, &bits, 8);
+        if (unit==librevenge::RVNG_GENERIC)
+          list.insert(key->c_str(), librevenge::RVNGPropertyFactory::newDoubleProp(val));
+        else
+          list.insert(key->c_str(), val, unit);
+        break;
+      }
+      case 'v': {
+        unsigned long numChild;
+        if (!readULong(numChild)) return false;
+        librevenge::RVNGPropertyListVector vect;
+        for (unsigned long c=0; c<numChild; ++c) {
+          librevenge::RVNGPropertyList child;
+          if (!readPropertyList(child)) return false;
+          vect.append(child);
+        }
+        list.insert(key->c_str(), vect);
+        break;
+      }
+      default:
+        STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readPropertyList: find unknown type %c for child %lu\n", char(type), i));
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //
+  // legacy format
+  //
+
+  //! tries to read the data created by libstaroffice 0.0.6 or older
+  bool readLegacyData(librevenge::RVNGBinaryData const &encoded)
   {
     try {
       auto *inp = const_cast<librevenge::RVNGInputStream *>(encoded.getDataStream());
@@ -185,7 +499,6 @@ public:
     return true;
   }
 
-protected:
   //! reads an simple element
   bool readInsertElement(librevenge::RVNGInputStream &input)
   {
@@ -196,7 +509,12 @@ protected:
       STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readInsertElement find empty tag\n"));
       return false;
     }
-    if (m_handler) m_handler->insertElement(s.cstr());
+    auto tag=STOFFPropertyHandler::getTag(s.cstr());
+    if (tag==STOFFPropertyHandler::T_Unknown) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readInsertElement find unknown tag %s\n", s.cstr()));
+      return false;
+    }
+    if (m_handler) m_handler->insertElement(tag);
     return true;
   }
 
@@ -210,6 +528,11 @@ protected:
       STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readInsertElementWithProperty: find empty tag\n"));
       return false;
     }
+    auto tag=STOFFPropertyHandler::getTag(s.cstr());
+    if (tag==STOFFPropertyHandler::T_Unknown) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readInsertElementWithProperty find unknown tag %s\n", s.cstr()));
+      return false;
+    }
     librevenge::RVNGPropertyList lists;
     if (!readPropertyList(input, lists)) {
       STOFF_DEBUG_MSG(("STOFFPropertyHandlerDecoder::readInsertElementWithProperty: can not read propertyList for tag %s\n",
@@ -217,7 +540,7 @@ protected:
       return false;
     }
 
-    if (m_handler) m_handler->insertElement(s.cstr(), lists);
+    if (m_handler) m_handler->insertElement(tag, lists);
     return true;
   }
 
@@ -349,6 +672,12 @@ private:
 protected:
   //! the streamfile
   STOFFPropertyHandler *m_handler;
+  //! the actual position in the compact data
+  unsigned char const *m_pos;
+  //! the end of the compact data
+  unsigned char const *m_end;
+  //! the list of keys
+  std::deque<std::string> m_keyList;
 };
 
 ////////////////////////////////////////////////////
@@ -360,6 +689,26 @@ STOFFPropertyHandler::~STOFFPropertyHandler()
 {
 }
 
+STOFFPropertyHandler::Tag STOFFPropertyHandler::getTag(char const *name)
+{
+  static std::map<std::string, Tag> const s_nameToTagMap=[]() {
+    std::map<std::string, Tag> res;
+    for (int i=1; i<int(T_MaxTag); ++i)
+      res[STOFFPropertyHandlerInternal::s_tagNames[i]]=Tag(i);
+    return res;
+  }();
+  if (!name) return T_Unknown;
+  auto it=s_nameToTagMap.find(name);
+  return it==s_nameToTagMap.end() ? T_Unknown : it->second;
+}
+
+char const *STOFFPropertyHandler::getTagName(Tag tag)
+{
+  if (int(tag)<=0 || int(tag)>=int(T_MaxTag))
+    return "";
+  return STOFFPropertyHandlerInternal::s_tagNames[int(tag)];
+}
+
 bool STOFFPropertyHandler::checkData(librevenge::RVNGBinaryData const &encoded)
 {
   STOFFPropertyHandlerDecoder decod;
@@ -372,4 +721,27 @@ bool STOFFPropertyHandler::readData(librevenge::RVNGBinaryData const &encoded)
   return decod.readData(encoded);
 }
 
+bool STOFFPropertyHandler::replayCalls(librevenge::RVNGPropertyListVector const &calls)
+{
+  for (unsigned long c=0; c<calls.count(); ++c) {
+    auto const &call=calls[c];
+    int tag=call["librevenge:stoff-tag"] ? call["librevenge:stoff-tag"]->getInt() : -1;
+    if (tag<0 || tag>=int(T_MaxTag)) {
+      STOFF_DEBUG_MSG(("STOFFPropertyHandler::replayCalls: find unexpected tag %d\n", tag));
+      return false;
+    }
+    if (tag==int(T_Unknown)) {
+      if (call["librevenge:stoff-characters"])
+        characters(call["librevenge:stoff-characters"]->getStr());
+      continue;
+    }
+    auto const *properties=call.child("librevenge:stoff-properties");
+    if (properties && properties->count()==1)
+      insertElement(Tag(tag), (*properties)[0]);
+    else
+      insertElement(Tag(tag));
+  }
+  return true;
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -35,23 +35,48 @@
 #  define STOFF_PROPERTY_HANDLER
 
 #  include <assert.h>
+#  include <map>
+#  include <memory>
 #  include <ostream>
-#  include <sstream>
 #  include <string>
 
 //! a generic property handler
 class STOFFPropertyHandler
 {
 public:
+  /** the list of elements which can be stored.
+
+      \note the values are stored in the compact format, so new tags must be
+      added before T_MaxTag and the existing tags must not be reordered */
+  enum Tag {
+    T_Unknown=0, T_CloseChart, T_CloseChartPlotArea, T_CloseChartSerie, T_CloseChartTextObject,
+    T_CloseComment, T_CloseFooter, T_CloseFootnote, T_CloseFrame, T_CloseGroup, T_CloseHeader,
+    T_CloseLink, T_CloseListElement, T_CloseOrderedListLevel, T_ClosePageSpan, T_CloseParagraph,
+    T_CloseSection, T_CloseSheet, T_CloseSheetCell, T_CloseSheetRow, T_CloseSpan, T_CloseTable,
+    T_CloseTableCell, T_CloseTableRow, T_CloseTextBox, T_CloseUnorderedListLevel,
+    T_DefineCharacterStyle, T_DefineChartStyle, T_DefineEmbeddedFont, T_DefineGraphicStyle,
+    T_DefinePageStyle, T_DefineParagraphStyle, T_DefineSectionStyle, T_DefineSheetNumberingStyle,
+    T_DrawConnector, T_DrawEllipse, T_DrawGraphicObject, T_DrawPath, T_DrawPolygon, T_DrawPolyline,
+    T_DrawRectangle, T_EndDocument, T_EndEmbeddedGraphics, T_EndLayer, T_EndMasterPage, T_EndPage,
+    T_EndTableObject, T_EndTextObject, T_InsertBinaryObject, T_InsertChartAxis,
+    T_InsertCoveredTableCell, T_InsertEquation, T_InsertField, T_InsertLineBreak, T_InsertSpace,
+    T_InsertTab, T_OpenChart, T_OpenChartPlotArea, T_OpenChartSerie, T_OpenChartTextObject,
+    T_OpenComment, T_OpenFooter, T_OpenFootnote, T_OpenFrame, T_OpenGroup, T_OpenHeader, T_OpenLink,
+    T_OpenListElement, T_OpenOrderedListLevel, T_OpenPageSpan, T_OpenParagraph, T_OpenSection,
+    T_OpenSheet, T_OpenSheetCell, T_OpenSheetRow, T_OpenSpan, T_OpenTable, T_OpenTableCell,
+    T_OpenTableRow, T_OpenTextBox, T_OpenUnorderedListLevel, T_SetDocumentMetaData, T_SetStyle,
+    T_StartDocument, T_StartEmbeddedGraphics, T_StartLayer, T_StartMasterPage, T_StartPage,
+    T_StartTableObject, T_StartTextObject, T_MaxTag
+  };
   //! constructor
   STOFFPropertyHandler() {}
   //! destructor
   virtual ~STOFFPropertyHandler();
 
   //! inserts a simple element
-  virtual void insertElement(const char *psName) = 0;
+  virtual void insertElement(Tag tag) = 0;
   //! inserts an element ( given a property list )
-  virtual void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList) = 0;
+  virtual void insertElement(Tag tag, const librevenge::RVNGPropertyList &xPropList) = 0;
   //! writes a list of characters
   virtual void characters(librevenge::RVNGString const &sCharacters) = 0;
 
@@ -59,25 +84,45 @@ public:
   bool checkData(librevenge::RVNGBinaryData const &encoded);
   //! reads a encoded librevenge::RVNGBinaryData created by STOFFPropertyHandlerEncoder
   bool readData(librevenge::RVNGBinaryData const &encoded);
+  /** sends a list of calls recorded by STOFFPropertyHandlerEncoder, each call being stored in a property list:
+      - "librevenge:stoff-tag": the element tag (or T_Unknown for a list of characters)
+      - "librevenge:stoff-properties": a vector which contains the element property list (if any)
+      - "librevenge:stoff-characters": the characters (for T_Unknown) */
+  bool replayCalls(librevenge::RVNGPropertyListVector const &calls);
+
+  //! returns the tag corresponding to an element name (or T_Unknown)
+  static Tag getTag(char const *name);
+  //! returns the element name corresponding to a tag
+  static char const *getTagName(Tag tag);
 };
 
 /*! \brief write in librevenge::RVNGBinaryData a list of tags/and properties
  *
  * In order to be read by writerperfect, we must code document consisting in
- * tag and propertyList in an intermediar format:
- *  - [string:s]: an int length(s) follow by the length(s) characters of string s
- *  - [property:p]: a string value p.getStr() ( for a basic property )
- *  - [propertyList:pList]: a int: \#pList followed by
- *      -+ 'p',pList[i].key(),pList[i] for a basic child
- *      -+ 'v',pList[i].key(),*(pList.child(pList[i].key())) for a vector child
- *  - [propertyListVector:v]: a int: \#v followed by v[0], v[1], ...
- *  - [binaryData:d]: a int32 d.size() followed by the data content
+ * tag and propertyList in an intermediar format. The current format (version 1) is:
+ *  - [header]: the 6 characters "\0STOFF" followed by the version number (a byte)
+ *  - [uint:u]: a variable length unsigned integer, 7 bits by bytes (the high bit is set if another byte follows)
+ *  - [string:s]: an uint length(s) follow by the length(s) characters of string s
+ *  - [key:k]: an uint id: 0 if this is a new key, followed by a [string]; the n-th new key has id n
+ *  - [property:p]: a type followed by the value:
+ *      -+ 's' followed by a [string] p.getStr() ( default )
+ *      -+ 'i' followed by an [uint] (zigzag encoded) for an integer
+ *      -+ 'b' or 'B' for a boolean false or true
+ *      -+ 'd' followed by a byte: the unit, and a 8 bytes double for a double
+ *  - [propertyList:pList]: an uint: \#pList followed by
+ *      -+ [key] pList[i].key() followed by [property] pList[i] for a basic child
+ *      -+ [key] pList[i].key(), 'v' followed by *(pList.child(pList[i].key())) for a vector child
+ *  - [propertyListVector:v]: an uint: \#v followed by v[0], v[1], ...
  *
- *  - [insertElement:name]: char 'E', [string] name
- *  - [insertElement:name proplist:prop]: char 'S', [string] name, prop
- *  - [characters:s ]: char 'T', [string] s
+ *  - [insertElement:tag]: char 'e', [uint] tag
+ *  - [insertElement:tag proplist:prop]: char 's', [uint] tag, prop
+ *  - [characters:s ]: char 't', [string] s
  *            - if len(s)==0, we write nothing
  *            - the string is written as is (ie. we do not escaped any characters).
+ *
+ * \note the data created by the previous versions of libstaroffice (which do not begin by
+ * the header) are still read by STOFFPropertyHandler: they used 4 bytes integers, textual
+ * element names and stored each property value as p.getStr().
 */
 class STOFFPropertyHandlerEncoder
 {
@@ -86,28 +131,46 @@ public:
   STOFFPropertyHandlerEncoder();
 
   //! inserts an element
-  void insertElement(const char *psName);
+  void insertElement(STOFFPropertyHandler::Tag tag);
   //! inserts an element given a property list
-  void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList);
+  void insertElement(STOFFPropertyHandler::Tag tag, const librevenge::RVNGPropertyList &xPropList);
   //! writes a list of characters
   void characters(librevenge::RVNGString const &sCharacters);
   //! retrieves the data
   bool getData(librevenge::RVNGBinaryData &data);
+  //! asks the encoder to also store the calls in memory, see STOFFPropertyHandler::replayCalls
+  void setRecordCalls(bool record)
+  {
+    m_callList.reset(record ? new librevenge::RVNGPropertyListVector : nullptr);
+  }
+  //! returns the recorded calls (if setRecordCalls was called)
+  std::shared_ptr<librevenge::RVNGPropertyListVector const> getRecordedCalls() const
+  {
+    return m_callList;
+  }
 
 protected:
-  //! adds a long value if f
-  void writeLong(long val);
+  //! adds an unsigned value
+  void writeULong(unsigned long val);
   //! adds a string: size and string
-  void writeString(const librevenge::RVNGString &name);
-  //! adds a property: a string key, a string corresponding to value
+  void writeString(char const *str, unsigned long len);
+  //! adds a key: its id or 0 followed by the string
+  void writeKey(char const *key);
+  //! adds a double value: 'd', the unit and the value
+  void writeDouble(double val, librevenge::RVNGUnit unit);
+  //! adds a property: a key, a type and the value
   void writeProperty(const char *key, const librevenge::RVNGProperty &prop);
   //! adds a property list: int \#prop followed by the different properties
   void writePropertyList(const librevenge::RVNGPropertyList &prop);
   //! adds a property vector: a int: \#vect followed by vect[0], vect[1], ...
   void writePropertyListVector(const librevenge::RVNGPropertyListVector &vect);
 
-  //! the streamfile
-  std::stringstream m_f;
+  //! the data
+  std::string m_data;
+  //! a map key to id
+  std::map<std::string, unsigned long> m_keyToIdMap;
+  //! the recorded calls (if the calls are recorded)
+  std::shared_ptr<librevenge::RVNGPropertyListVector> m_callList;
 };
 
 #endif
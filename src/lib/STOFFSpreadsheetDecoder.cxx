@@ -33,8 +33,6 @@
 * instead of those above.
 */
 
-#include <string.h>
-
 #include <librevenge/librevenge.h>
 #include <libstaroffice/libstaroffice.hxx>
 
@@ -44,218 +42,249 @@
 
 #include "STOFFSpreadsheetDecoder.hxx"
 
-void STOFFSpreadsheetDecoder::insertElement(const char *psName)
+void STOFFSpreadsheetDecoder::insertElement(Tag tag)
 {
   if (!m_output) return;
-  if (!psName || !*psName) {
-    STOFF_DEBUG_MSG(("STOFFSpreadsheetDecoder::insertElement: called without any name\n"));
-    return;
-  }
-
-  bool ok=true;
-  switch (psName[0]) {
-  case 'C':
-    if (strcmp(psName,"CloseChart")==0)
-      m_output->closeChart();
-    else if (strcmp(psName,"CloseChartPlotArea")==0)
-      m_output->closeChartPlotArea();
-    else if (strcmp(psName,"CloseChartSerie")==0)
-      m_output->closeChartSerie();
-    else if (strcmp(psName,"CloseChartTextObject")==0)
-      m_output->closeChartTextObject();
-    else if (strcmp(psName,"CloseComment")==0)
-      m_output->closeComment();
-    else if (strcmp(psName,"CloseFooter")==0)
-      m_output->closeFooter();
-    else if (strcmp(psName,"CloseFootnote")==0)
-      m_output->closeFootnote();
-    else if (strcmp(psName,"CloseFrame")==0)
-      m_output->closeFrame();
-    else if (strcmp(psName,"CloseGroup")==0)
-      m_output->closeGroup();
-    else if (strcmp(psName,"CloseHeader")==0)
-      m_output->closeHeader();
-    else if (strcmp(psName,"CloseLink")==0)
-      m_output->closeLink();
-    else if (strcmp(psName,"CloseListElement")==0)
-      m_output->closeListElement();
-    else if (strcmp(psName,"CloseOrderedListLevel")==0)
-      m_output->closeOrderedListLevel();
-    else if (strcmp(psName,"ClosePageSpan")==0)
-      m_output->closePageSpan();
-    else if (strcmp(psName,"CloseParagraph")==0)
-      m_output->closeParagraph();
-    else if (strcmp(psName,"CloseSection")==0)
-      m_output->closeSection();
-    else if (strcmp(psName,"CloseSheet")==0)
-      m_output->closeSheet();
-    else if (strcmp(psName,"CloseSheetCell")==0)
-      m_output->closeSheetCell();
-    else if (strcmp(psName,"CloseSheetRow")==0)
-      m_output->closeSheetRow();
-    else if (strcmp(psName,"CloseSpan")==0)
-      m_output->closeSpan();
-    else if (strcmp(psName,"CloseTableCell")==0)
-      m_output->closeTableCell();
-    else if (strcmp(psName,"CloseTableRow")==0)
-      m_output->closeTableRow();
-    else if (strcmp(psName,"CloseTextBox")==0)
-      m_output->closeTextBox();
-    else if (strcmp(psName,"CloseUnorderedListLevel")==0)
-      m_output->closeUnorderedListLevel();
-    else
-      ok=false;
-    break;
-  case 'E':
-    if (strcmp(psName,"EndDocument")==0)
-      m_output->endDocument();
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (strcmp(psName,"InsertTab")==0)
-      m_output->insertTab();
-    else if (strcmp(psName,"InsertSpace")==0)
-      m_output->insertSpace();
-    else if (strcmp(psName,"InsertLineBreak")==0)
-      m_output->insertLineBreak();
-    else
-      ok=false;
+  switch (tag) {
+  case T_CloseChart:
+    m_output->closeChart();
+    break;
+  case T_CloseChartPlotArea:
+    m_output->closeChartPlotArea();
+    break;
+  case T_CloseChartSerie:
+    m_output->closeChartSerie();
+    break;
+  case T_CloseChartTextObject:
+    m_output->closeChartTextObject();
+    break;
+  case T_CloseComment:
+    m_output->closeComment();
+    break;
+  case T_CloseFooter:
+    m_output->closeFooter();
+    break;
+  case T_CloseFootnote:
+    m_output->closeFootnote();
+    break;
+  case T_CloseFrame:
+    m_output->closeFrame();
+    break;
+  case T_CloseGroup:
+    m_output->closeGroup();
+    break;
+  case T_CloseHeader:
+    m_output->closeHeader();
+    break;
+  case T_CloseLink:
+    m_output->closeLink();
+    break;
+  case T_CloseListElement:
+    m_output->closeListElement();
+    break;
+  case T_CloseOrderedListLevel:
+    m_output->closeOrderedListLevel();
+    break;
+  case T_ClosePageSpan:
+    m_output->closePageSpan();
+    break;
+  case T_CloseParagraph:
+    m_output->closeParagraph();
+    break;
+  case T_CloseSection:
+    m_output->closeSection();
+    break;
+  case T_CloseSheet:
+    m_output->closeSheet();
+    break;
+  case T_CloseSheetCell:
+    m_output->closeSheetCell();
+    break;
+  case T_CloseSheetRow:
+    m_output->closeSheetRow();
+    break;
+  case T_CloseSpan:
+    m_output->closeSpan();
+    break;
+  case T_CloseTable:
+    m_output->closeTable();
+    break;
+  case T_CloseTableCell:
+    m_output->closeTableCell();
+    break;
+  case T_CloseTableRow:
+    m_output->closeTableRow();
+    break;
+  case T_CloseTextBox:
+    m_output->closeTextBox();
+    break;
+  case T_CloseUnorderedListLevel:
+    m_output->closeUnorderedListLevel();
+    break;
+  case T_EndDocument:
+    m_output->endDocument();
+    break;
+  case T_InsertLineBreak:
+    m_output->insertLineBreak();
+    break;
+  case T_InsertSpace:
+    m_output->insertSpace();
+    break;
+  case T_InsertTab:
+    m_output->insertTab();
     break;
   default:
-    ok=false;
+    STOFF_DEBUG_MSG(("STOFFSpreadsheetDecoder::insertElement: called with unexpected tag %s\n", getTagName(tag)));
     break;
   }
-  if (!ok) {
-    STOFF_DEBUG_MSG(("STOFFSpreadsheetDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
-void STOFFSpreadsheetDecoder::insertElement(const char *psName, const librevenge::RVNGPropertyList &propList)
+void STOFFSpreadsheetDecoder::insertElement(Tag tag, const librevenge::RVNGPropertyList &propList)
 {
   if (!m_output) return;
-  if (!psName || !*psName) {
-    STOFF_DEBUG_MSG(("STOFFSpreadsheetDecoder::insertElement: called without any name\n"));
-    return;
-  }
-
-  bool ok=true;
-  switch (psName[0]) {
-  case 'D':
-    if (strcmp(psName,"DefineCharacterStyle")==0)
-      m_output->defineCharacterStyle(propList);
-    else if (strcmp(psName,"DefineChartStyle")==0)
-      m_output->defineChartStyle(propList);
-    else if (strcmp(psName,"DefineEmbeddedFont")==0)
-      m_output->defineEmbeddedFont(propList);
-    else if (strcmp(psName,"DefineGraphicStyle")==0)
-      m_output->defineGraphicStyle(propList);
-    else if (strcmp(psName,"DefinePageStyle")==0)
-      m_output->definePageStyle(propList);
-    else if (strcmp(psName,"DefineParagraphStyle")==0)
-      m_output->defineParagraphStyle(propList);
-    else if (strcmp(psName,"DefineSectionStyle")==0)
-      m_output->defineSectionStyle(propList);
-    else if (strcmp(psName,"DefineSheetNumberingStyle")==0)
-      m_output->defineSheetNumberingStyle(propList);
-
-    else if (strcmp(psName,"DrawConnector")==0)
-      m_output->drawConnector(propList);
-    else if (strcmp(psName,"DrawEllipse")==0)
-      m_output->drawEllipse(propList);
-    else if (strcmp(psName,"DrawPath")==0)
-      m_output->drawPath(propList);
-    else if (strcmp(psName,"DrawPolygon")==0)
-      m_output->drawPolygon(propList);
-    else if (strcmp(psName,"DrawPolyline")==0)
-      m_output->drawPolyline(propList);
-    else if (strcmp(psName,"DrawRectangle")==0)
-      m_output->drawRectangle(propList);
-    else
-      ok=false;
-    break;
-  case 'I':
-    if (strcmp(psName,"InsertBinaryObject")==0)
-      m_output->insertBinaryObject(propList);
-    else if (strcmp(psName,"InsertChartAxis")==0)
-      m_output->insertChartAxis(propList);
-    else if (strcmp(psName,"InsertCoveredTableCell")==0)
-      m_output->insertCoveredTableCell(propList);
-    else if (strcmp(psName,"InsertEquation")==0)
-      m_output->insertEquation(propList);
-    else if (strcmp(psName,"InsertField")==0)
-      m_output->insertField(propList);
-    else
-      ok=false;
-    break;
-  case 'O':
-    if (strcmp(psName,"OpenChart")==0)
-      m_output->openChart(propList);
-    else if (strcmp(psName,"OpenChartPlotArea")==0)
-      m_output->openChartPlotArea(propList);
-    else if (strcmp(psName,"OpenChartSerie")==0)
-      m_output->openChartSerie(propList);
-    else if (strcmp(psName,"OpenChartTextObject")==0)
-      m_output->openChartTextObject(propList);
-    else if (strcmp(psName,"OpenComment")==0)
-      m_output->openComment(propList);
-    else if (strcmp(psName,"OpenFooter")==0)
-      m_output->openFooter(propList);
-    else if (strcmp(psName,"OpenFootnote")==0)
-      m_output->openFootnote(propList);
-    else if (strcmp(psName,"OpenFrame")==0)
-      m_output->openFrame(propList);
-    else if (strcmp(psName,"OpenGroup")==0)
-      m_output->openGroup(propList);
-    else if (strcmp(psName,"OpenHeader")==0)
-      m_output->openHeader(propList);
-    else if (strcmp(psName,"OpenLink")==0)
-      m_output->openLink(propList);
-    else if (strcmp(psName,"OpenListElement")==0)
-      m_output->openListElement(propList);
-    else if (strcmp(psName,"OpenOrderedListLevel")==0)
-      m_output->openOrderedListLevel(propList);
-    else if (strcmp(psName,"OpenPageSpan")==0)
-      m_output->openPageSpan(propList);
-    else if (strcmp(psName,"OpenParagraph")==0)
-      m_output->openParagraph(propList);
-    else if (strcmp(psName,"OpenSheet")==0)
-      m_output->openSheet(propList);
-    else if (strcmp(psName,"OpenSection")==0)
-      m_output->openSection(propList);
-    else if (strcmp(psName,"OpenSheetCell")==0)
-      m_output->openSheetCell(propList);
-    else if (strcmp(psName,"OpenSheetRow")==0)
-      m_output->openSheetRow(propList);
-    else if (strcmp(psName,"OpenSpan")==0)
-      m_output->openSpan(propList);
-    else if (strcmp(psName,"OpenTableCell")==0)
-      m_output->openTableCell(propList);
-    else if (strcmp(psName,"OpenTableRow")==0)
-      m_output->openTableRow(propList);
-    else if (strcmp(psName,"OpenTextBox")==0)
-      m_output->openTextBox(propList);
-    else if (strcmp(psName,"OpenUnorderedListLevel")==0)
-      m_output->openUnorderedListLevel(propList);
-    else
-      ok=false;
-    break;
-  case 'S':
-    if (strcmp(psName,"SetDocumentMetaData")==0)
-      m_output->setDocumentMetaData(propList);
-    else if (strcmp(psName,"StartDocument")==0)
-      m_output->startDocument(propList);
-
-    else
-      ok=false;
+  switch (tag) {
+  case T_DefineCharacterStyle:
+    m_output->defineCharacterStyle(propList);
+    break;
+  case T_DefineChartStyle:
+    m_output->defineChartStyle(propList);
+    break;
+  case T_DefineEmbeddedFont:
+    m_output->defineEmbeddedFont(propList);
+    break;
+  case T_DefineGraphicStyle:
+    m_output->defineGraphicStyle(propList);
+    break;
+  case T_DefinePageStyle:
+    m_output->definePageStyle(propList);
+    break;
+  case T_DefineParagraphStyle:
+    m_output->defineParagraphStyle(propList);
+    break;
+  case T_DefineSectionStyle:
+    m_output->defineSectionStyle(propList);
+    break;
+  case T_DefineSheetNumberingStyle:
+    m_output->defineSheetNumberingStyle(propList);
+    break;
+  case T_DrawConnector:
+    m_output->drawConnector(propList);
+    break;
+  case T_DrawEllipse:
+    m_output->drawEllipse(propList);
+    break;
+  case T_DrawPath:
+    m_output->drawPath(propList);
+    break;
+  case T_DrawPolygon:
+    m_output->drawPolygon(propList);
+    break;
+  case T_DrawPolyline:
+    m_output->drawPolyline(propList);
+    break;
+  case T_DrawRectangle:
+    m_output->drawRectangle(propList);
+    break;
+  case T_InsertBinaryObject:
+    m_output->insertBinaryObject(propList);
+    break;
+  case T_InsertChartAxis:
+    m_output->insertChartAxis(propList);
+    break;
+  case T_InsertCoveredTableCell:
+    m_output->insertCoveredTableCell(propList);
+    break;
+  case T_InsertEquation:
+    m_output->insertEquation(propList);
+    break;
+  case T_InsertField:
+    m_output->insertField(propList);
+    break;
+  case T_OpenChart:
+    m_output->openChart(propList);
+    break;
+  case T_OpenChartPlotArea:
+    m_output->openChartPlotArea(propList);
+    break;
+  case T_OpenChartSerie:
+    m_output->openChartSerie(propList);
+    break;
+  case T_OpenChartTextObject:
+    m_output->openChartTextObject(propList);
+    break;
+  case T_OpenComment:
+    m_output->openComment(propList);
+    break;
+  case T_OpenFooter:
+    m_output->openFooter(propList);
+    break;
+  case T_OpenFootnote:
+    m_output->openFootnote(propList);
+    break;
+  case T_OpenFrame:
+    m_output->openFrame(propList);
+    break;
+  case T_OpenGroup:
+    m_output->openGroup(propList);
+    break;
+  case T_OpenHeader:
+    m_output->openHeader(propList);
+    break;
+  case T_OpenLink:
+    m_output->openLink(propList);
+    break;
+  case T_OpenListElement:
+    m_output->openListElement(propList);
+    break;
+  case T_OpenOrderedListLevel:
+    m_output->openOrderedListLevel(propList);
+    break;
+  case T_OpenPageSpan:
+    m_output->openPageSpan(propList);
+    break;
+  case T_OpenParagraph:
+    m_output->openParagraph(propList);
+    break;
+  case T_OpenSection:
+    m_output->openSection(propList);
+    break;
+  case T_OpenSheet:
+    m_output->openSheet(propList);
+    break;
+  case T_OpenSheetCell:
+    m_output->openSheetCell(propList);
+    break;
+  case T_OpenSheetRow:
+    m_output->openSheetRow(propList);
+    break;
+  case T_OpenSpan:
+    m_output->openSpan(propList);
+    break;
+  case T_OpenTable:
+    m_output->openTable(propList);
+    break;
+  case T_OpenTableCell:
+    m_output->openTableCell(propList);
+    break;
+  case T_OpenTableRow:
+    m_output->openTableRow(propList);
+    break;
+  case T_OpenTextBox:
+    m_output->openTextBox(propList);
+    break;
+  case T_OpenUnorderedListLevel:
+    m_output->openUnorderedListLevel(propList);
+    break;
+  case T_SetDocumentMetaData:
+    m_output->setDocumentMetaData(propList);
+    break;
+  case T_StartDocument:
+    m_output->startDocument(propList);
     break;
   default:
-    ok=false;
+    STOFF_DEBUG_MSG(("STOFFSpreadsheetDecoder::insertElement: called with unexpected tag %s\n", getTagName(tag)));
     break;
   }
-  if (!ok) {
-    STOFF_DEBUG_MSG(("STOFFSpreadsheetDecoder::insertElement: called with unexpected name %s\n", psName));
-  }
 }
 
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -56,12 +56,9 @@ public:
   ~STOFFSpreadsheetDecoder() final {}
 
   /** insert an element */
-  void insertElement(const char *psName) final;
+  void insertElement(Tag tag) final;
   /** insert an element ( with a librevenge::RVNGPropertyList ) */
-  void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList) final;
-  /** insert an element ( with a librevenge::RVNGPropertyListVector parameter ) */
-  void insertElement(const char *psName, const librevenge::RVNGPropertyList &xPropList,
-                     const librevenge::RVNGPropertyListVector &vector);
+  void insertElement(Tag tag, const librevenge::RVNGPropertyList &xPropList) final;
   /** insert a sequence of character */
   void characters(const librevenge::RVNGString &sCharacters) final
   {
@@ -54,9 +54,10 @@ namespace STOFFSpreadsheetEncoderInternal
 //! the state of a STOFFSpreadsheetEncoder
 struct State {
   //! constructor
-  State()
+  explicit State(bool recordCalls)
     : m_encoder()
   {
+    m_encoder.setRecordCalls(recordCalls);
   }
   //! the encoder
   STOFFPropertyHandlerEncoder m_encoder;
@@ -64,9 +65,9 @@ struct State {
 
 }
 
-STOFFSpreadsheetEncoder::STOFFSpreadsheetEncoder()
+STOFFSpreadsheetEncoder::STOFFSpreadsheetEncoder(bool recordCalls)
   : librevenge::RVNGSpreadsheetInterface()
-  , m_state(new STOFFSpreadsheetEncoderInternal::State)
+  , m_state(new STOFFSpreadsheetEncoderInternal::State(recordCalls))
 {
 }
 
@@ -80,22 +81,23 @@ bool STOFFSpreadsheetEncoder::getBinaryResult(STOFFEmbeddedObject &object)
   if (!m_state->m_encoder.getData(data))
     return false;
   object=STOFFEmbeddedObject(data, "image/stoff-ods");
+  object.m_callList=m_state->m_encoder.getRecordedCalls();
   return true;
 }
 
 void STOFFSpreadsheetEncoder::setDocumentMetaData(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("SetDocumentMetaData", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_SetDocumentMetaData, list);
 }
 
 void STOFFSpreadsheetEncoder::startDocument(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("StartDocument", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_StartDocument, list);
 }
 
 void STOFFSpreadsheetEncoder::endDocument()
 {
-  m_state->m_encoder.insertElement("EndDocument");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_EndDocument);
 }
 
 //
@@ -103,39 +105,39 @@ void STOFFSpreadsheetEncoder::endDocument()
 //
 void STOFFSpreadsheetEncoder::definePageStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefinePageStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefinePageStyle, list);
 }
 
 void STOFFSpreadsheetEncoder::defineEmbeddedFont(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineEmbeddedFont", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineEmbeddedFont, list);
 }
 
 void STOFFSpreadsheetEncoder::openPageSpan(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenPageSpan", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenPageSpan, list);
 }
 void STOFFSpreadsheetEncoder::closePageSpan()
 {
-  m_state->m_encoder.insertElement("ClosePageSpan");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_ClosePageSpan);
 }
 
 void STOFFSpreadsheetEncoder::openHeader(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenHeader", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenHeader, list);
 }
 void STOFFSpreadsheetEncoder::closeHeader()
 {
-  m_state->m_encoder.insertElement("CloseHeader");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseHeader);
 }
 
 void STOFFSpreadsheetEncoder::openFooter(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenFooter", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenFooter, list);
 }
 void STOFFSpreadsheetEncoder::closeFooter()
 {
-  m_state->m_encoder.insertElement("CloseFooter");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseFooter);
 }
 
 //
@@ -143,34 +145,34 @@ void STOFFSpreadsheetEncoder::closeFooter()
 //
 void STOFFSpreadsheetEncoder::defineSheetNumberingStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineSheetNumberingStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineSheetNumberingStyle, list);
 }
 void STOFFSpreadsheetEncoder::openSheet(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenSheet", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenSheet, list);
 }
 void STOFFSpreadsheetEncoder::closeSheet()
 {
-  m_state->m_encoder.insertElement("CloseSheet");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseSheet);
 }
 void STOFFSpreadsheetEncoder::openSheetRow(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenSheetRow", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenSheetRow, list);
 }
 
 void STOFFSpreadsheetEncoder::closeSheetRow()
 {
-  m_state->m_encoder.insertElement("CloseSheetRow");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseSheetRow);
 }
 
 void STOFFSpreadsheetEncoder::openSheetCell(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenSheetCell", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenSheetCell, list);
 }
 
 void STOFFSpreadsheetEncoder::closeSheetCell()
 {
-  m_state->m_encoder.insertElement("CloseSheetCell");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseSheetCell);
 }
 
 //
@@ -179,52 +181,52 @@ void STOFFSpreadsheetEncoder::closeSheetCell()
 
 void STOFFSpreadsheetEncoder::defineChartStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineChartStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineChartStyle, list);
 }
 
 void STOFFSpreadsheetEncoder::openChart(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenChart", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenChart, list);
 }
 
 void STOFFSpreadsheetEncoder::closeChart()
 {
-  m_state->m_encoder.insertElement("CloseChart");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseChart);
 }
 
 void STOFFSpreadsheetEncoder::openChartTextObject(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenChartTextObject", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenChartTextObject, list);
 }
 
 void STOFFSpreadsheetEncoder::closeChartTextObject()
 {
-  m_state->m_encoder.insertElement("CloseChartTextObject");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseChartTextObject);
 }
 
 void STOFFSpreadsheetEncoder::openChartPlotArea(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenChartPlotArea", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenChartPlotArea, list);
 }
 
 void STOFFSpreadsheetEncoder::closeChartPlotArea()
 {
-  m_state->m_encoder.insertElement("CloseChartPlotArea");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseChartPlotArea);
 }
 
 void STOFFSpreadsheetEncoder::insertChartAxis(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertChartAxis", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertChartAxis, list);
 }
 
 void STOFFSpreadsheetEncoder::openChartSerie(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenChartSerie", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenChartSerie, list);
 }
 
 void STOFFSpreadsheetEncoder::closeChartSerie()
 {
-  m_state->m_encoder.insertElement("CloseChartSerie");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseChartSerie);
 }
 
 
@@ -233,42 +235,42 @@ void STOFFSpreadsheetEncoder::closeChartSerie()
 //
 void STOFFSpreadsheetEncoder::defineParagraphStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineParagraphStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineParagraphStyle, list);
 }
 
 void STOFFSpreadsheetEncoder::openParagraph(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenParagraph", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenParagraph, list);
 }
 
 void STOFFSpreadsheetEncoder::closeParagraph()
 {
-  m_state->m_encoder.insertElement("CloseParagraph");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseParagraph);
 }
 
 void STOFFSpreadsheetEncoder::defineCharacterStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineCharacterStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineCharacterStyle, list);
 }
 
 void STOFFSpreadsheetEncoder::openSpan(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenSpan", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenSpan, list);
 }
 
 void STOFFSpreadsheetEncoder::closeSpan()
 {
-  m_state->m_encoder.insertElement("CloseSpan");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseSpan);
 }
 
 void STOFFSpreadsheetEncoder::openLink(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenLink", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenLink, list);
 }
 
 void STOFFSpreadsheetEncoder::closeLink()
 {
-  m_state->m_encoder.insertElement("CloseLink");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseLink);
 }
 
 //
@@ -276,27 +278,27 @@ void STOFFSpreadsheetEncoder::closeLink()
 //
 void STOFFSpreadsheetEncoder::defineSectionStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineSectionStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineSectionStyle, list);
 }
 
 void STOFFSpreadsheetEncoder::openSection(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenSection", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenSection, list);
 }
 
 void STOFFSpreadsheetEncoder::closeSection()
 {
-  m_state->m_encoder.insertElement("CloseSection");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseSection);
 }
 
 void STOFFSpreadsheetEncoder::insertTab()
 {
-  m_state->m_encoder.insertElement("InsertTab");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertTab);
 }
 
 void STOFFSpreadsheetEncoder::insertSpace()
 {
-  m_state->m_encoder.insertElement("InsertSpace");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertSpace);
 }
 
 void STOFFSpreadsheetEncoder::insertText(const librevenge::RVNGString &text)
@@ -306,12 +308,12 @@ void STOFFSpreadsheetEncoder::insertText(const librevenge::RVNGString &text)
 
 void STOFFSpreadsheetEncoder::insertLineBreak()
 {
-  m_state->m_encoder.insertElement("InsertLineBreak");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertLineBreak);
 }
 
 void STOFFSpreadsheetEncoder::insertField(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertField", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertField, list);
 }
 
 //
@@ -319,32 +321,32 @@ void STOFFSpreadsheetEncoder::insertField(const librevenge::RVNGPropertyList &li
 //
 void STOFFSpreadsheetEncoder::openOrderedListLevel(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenOrderedListLevel", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenOrderedListLevel, list);
 }
 
 void STOFFSpreadsheetEncoder::openUnorderedListLevel(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenUnorderedListLevel", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenUnorderedListLevel, list);
 }
 
 void STOFFSpreadsheetEncoder::closeOrderedListLevel()
 {
-  m_state->m_encoder.insertElement("CloseOrderedListLevel");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseOrderedListLevel);
 }
 
 void STOFFSpreadsheetEncoder::closeUnorderedListLevel()
 {
-  m_state->m_encoder.insertElement("CloseOrderedListLevel");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseOrderedListLevel);
 }
 
 void STOFFSpreadsheetEncoder::openListElement(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenListElement", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenListElement, list);
 }
 
 void STOFFSpreadsheetEncoder::closeListElement()
 {
-  m_state->m_encoder.insertElement("CloseListElement");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseListElement);
 }
 
 //
@@ -353,34 +355,34 @@ void STOFFSpreadsheetEncoder::closeListElement()
 
 void STOFFSpreadsheetEncoder::openFootnote(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenFootnote", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenFootnote, list);
 }
 
 void STOFFSpreadsheetEncoder::closeFootnote()
 {
-  m_state->m_encoder.insertElement("CloseFootnote");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseFootnote);
 }
 
 void STOFFSpreadsheetEncoder::openComment(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenComment", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenComment, list);
 }
 void STOFFSpreadsheetEncoder::closeComment()
 {
-  m_state->m_encoder.insertElement("CloseComment");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseComment);
 }
 
 void STOFFSpreadsheetEncoder::openFrame(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenFrame", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenFrame, list);
 }
 void STOFFSpreadsheetEncoder::closeFrame()
 {
-  m_state->m_encoder.insertElement("CloseFrame");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseFrame);
 }
 void STOFFSpreadsheetEncoder::insertBinaryObject(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertBinaryObject", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertBinaryObject, list);
 }
 
 //
@@ -388,45 +390,45 @@ void STOFFSpreadsheetEncoder::insertBinaryObject(const librevenge::RVNGPropertyL
 //
 void STOFFSpreadsheetEncoder::openTextBox(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenTextBox", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenTextBox, list);
 }
 
 void STOFFSpreadsheetEncoder::closeTextBox()
 {
-  m_state->m_encoder.insertElement("CloseTextBox");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseTextBox);
 }
 
 void STOFFSpreadsheetEncoder::openTable(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenTable", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenTable, list);
 }
 void STOFFSpreadsheetEncoder::closeTable()
 {
-  m_state->m_encoder.insertElement("CloseTable");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseTable);
 }
 void STOFFSpreadsheetEncoder::openTableRow(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenTableRow", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenTableRow, list);
 }
 
 void STOFFSpreadsheetEncoder::closeTableRow()
 {
-  m_state->m_encoder.insertElement("CloseTableRow");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseTableRow);
 }
 
 void STOFFSpreadsheetEncoder::openTableCell(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenTableCell", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenTableCell, list);
 }
 
 void STOFFSpreadsheetEncoder::closeTableCell()
 {
-  m_state->m_encoder.insertElement("CloseTableCell");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseTableCell);
 }
 
 void STOFFSpreadsheetEncoder::insertCoveredTableCell(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertCoveredTableCell", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertCoveredTableCell, list);
 }
 
 //
@@ -435,47 +437,47 @@ void STOFFSpreadsheetEncoder::insertCoveredTableCell(const librevenge::RVNGPrope
 
 void STOFFSpreadsheetEncoder::openGroup(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("OpenGroup", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_OpenGroup, list);
 }
 
 void STOFFSpreadsheetEncoder::closeGroup()
 {
-  m_state->m_encoder.insertElement("CloseGroup");
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_CloseGroup);
 }
 
 void STOFFSpreadsheetEncoder::defineGraphicStyle(const librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DefineGraphicStyle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DefineGraphicStyle, list);
 }
 
 void STOFFSpreadsheetEncoder::drawRectangle(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawRectangle", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawRectangle, list);
 }
 
 void STOFFSpreadsheetEncoder::drawEllipse(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawEllipse", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawEllipse, list);
 }
 
 void STOFFSpreadsheetEncoder::drawPolygon(const ::librevenge::RVNGPropertyList &vertices)
 {
-  m_state->m_encoder.insertElement("DrawPolygon", vertices);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawPolygon, vertices);
 }
 
 void STOFFSpreadsheetEncoder::drawPolyline(const ::librevenge::RVNGPropertyList &vertices)
 {
-  m_state->m_encoder.insertElement("DrawPolyline", vertices);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawPolyline, vertices);
 }
 
 void STOFFSpreadsheetEncoder::drawPath(const ::librevenge::RVNGPropertyList &path)
 {
-  m_state->m_encoder.insertElement("DrawPath", path);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawPath, path);
 }
 
 void STOFFSpreadsheetEncoder::drawConnector(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("DrawConnector", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_DrawConnector, list);
 }
 
 //
@@ -483,7 +485,7 @@ void STOFFSpreadsheetEncoder::drawConnector(const ::librevenge::RVNGPropertyList
 //
 void STOFFSpreadsheetEncoder::insertEquation(const ::librevenge::RVNGPropertyList &list)
 {
-  m_state->m_encoder.insertElement("InsertEquation", list);
+  m_state->m_encoder.insertElement(STOFFPropertyHandler::T_InsertEquation, list);
 }
 
 
@@ -55,8 +55,11 @@ struct State;
 class STOFFSpreadsheetEncoder final : public librevenge::RVNGSpreadsheetInterface
 {
 public:
-  /// constructor
-  STOFFSpreadsheetEncoder();
+  /** constructor
+
+      \param recordCalls if set, the calls are also stored in memory and attached to the object
+      returned by getBinaryResult, so that STOFFDocument::decodeSpreadsheet can replay them directly */
+  explicit STOFFSpreadsheetEncoder(bool recordCalls=false);
   /// destructor
   ~STOFFSpreadsheetEncoder() final;
   /// return the final spreadsheet
@@ -147,6 +147,8 @@ struct State {
 
   //! a buffer to stored the text
   librevenge::RVNGString m_textBuffer;
+  //! true if the text buffer can contain some consecutive spaces
+  bool m_textBufferHasConsecutiveSpaces;
   //! the number of tabs to add
   int m_numDeferredTabs;
 
@@ -196,6 +198,7 @@ private:
 
 State::State()
   : m_textBuffer("")
+  , m_textBufferHasConsecutiveSpaces(false)
   , m_numDeferredTabs(0)
 
   , m_font()
@@ -311,6 +314,8 @@ void STOFFSpreadsheetListener::insertChar(uint8_t character)
   }
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (character==' ' && libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, " "))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   m_ps->m_textBuffer.append(char(character));
 }
 
@@ -333,9 +338,24 @@ void STOFFSpreadsheetListener::insertUnicode(uint32_t val)
 
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (val==0x20 && libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, " "))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   libstoff::appendUnicode(val, m_ps->m_textBuffer);
 }
 
+void STOFFSpreadsheetListener::insertUnicodeRun(uint32_t const *chars, size_t numChars)
+{
+  if (!m_ps->canWriteText()) {
+    STOFF_DEBUG_MSG(("STOFFSpreadsheetListener::insertUnicodeRun: called outside a text zone\n"));
+    return;
+  }
+  if (!chars || !numChars) return;
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  if (libstoff::appendUnicodeRun(chars, numChars, m_ps->m_textBuffer))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
+}
+
 void STOFFSpreadsheetListener::insertUnicodeString(librevenge::RVNGString const &str)
 {
   if (!m_ps->canWriteText()) {
@@ -345,6 +365,8 @@ void STOFFSpreadsheetListener::insertUnicodeString(librevenge::RVNGString const
 
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, str.cstr()))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   m_ps->m_textBuffer.append(str);
 }
 
@@ -944,6 +966,12 @@ void STOFFSpreadsheetListener::_flushText()
 {
   if (m_ps->m_textBuffer.len() == 0  || !m_ps->canWriteText()) return;
 
+  if (!m_ps->m_textBufferHasConsecutiveSpaces) {
+    m_documentInterface->insertText(m_ps->m_textBuffer);
+    m_ps->m_textBuffer.clear();
+    return;
+  }
+
   // when some many ' ' follows each other, call insertSpace
   librevenge::RVNGString tmpText;
   int numConsecutiveSpaces = 0;
@@ -966,6 +994,7 @@ void STOFFSpreadsheetListener::_flushText()
   }
   m_documentInterface->insertText(tmpText);
   m_ps->m_textBuffer.clear();
+  m_ps->m_textBufferHasConsecutiveSpaces=false;
 }
 
 ///////////////////
@@ -1371,6 +1400,7 @@ void STOFFSpreadsheetListener::openSheet(std::vector<float> const &colWidth, lib
     STOFF_DEBUG_MSG(("STOFFSpreadsheetListener::openSheet: called with m_isSheetOpened=true\n"));
     return;
   }
+  updateParseControl();
   if (!m_ps->m_isPageSpanOpened)
     _openPageSpan();
   if (m_ps->m_isParagraphOpened)
@@ -153,6 +153,8 @@ public:
   /** adds an unicode character.
    *  By convention if \a character=0xfffd(undef), no character is added */
   void insertUnicode(uint32_t character) final;
+  //! adds a run of unicode characters
+  void insertUnicodeRun(uint32_t const *chars, size_t numChars) final;
   //! adds a unicode string
   void insertUnicodeString(librevenge::RVNGString const &str) final;
 
@@ -32,12 +32,21 @@ class STOFFStringStreamPrivate
 public:
   //! constructor
   STOFFStringStreamPrivate(const unsigned char *data, unsigned dataSize);
+  //! constructor from a shared buffer
+  explicit STOFFStringStreamPrivate(std::shared_ptr<std::vector<unsigned char> const> const &buffer);
   //! destructor
   ~STOFFStringStreamPrivate();
   //! append some data at the end of the actual stream
   void append(const unsigned char *data, unsigned dataSize);
+  //! returns the stream buffer
+  std::vector<unsigned char> const &buffer() const
+  {
+    return m_sharedBuffer ? *m_sharedBuffer : m_buffer;
+  }
   //! the stream buffer
   std::vector<unsigned char> m_buffer;
+  //! the shared stream buffer (if the buffer is shared)
+  std::shared_ptr<std::vector<unsigned char> const> m_sharedBuffer;
   //! the stream offset
   long m_offset;
 private:
@@ -47,11 +56,19 @@ private:
 
 STOFFStringStreamPrivate::STOFFStringStreamPrivate(const unsigned char *data, unsigned dataSize)
   : m_buffer(dataSize)
+  , m_sharedBuffer()
   , m_offset(0)
 {
   std::memcpy(&m_buffer[0], data, dataSize);
 }
 
+STOFFStringStreamPrivate::STOFFStringStreamPrivate(std::shared_ptr<std::vector<unsigned char> const> const &buffer)
+  : m_buffer()
+  , m_sharedBuffer(buffer)
+  , m_offset(0)
+{
+}
+
 STOFFStringStreamPrivate::~STOFFStringStreamPrivate()
 {
 }
@@ -59,6 +76,10 @@ STOFFStringStreamPrivate::~STOFFStringStreamPrivate()
 void STOFFStringStreamPrivate::append(const unsigned char *data, unsigned dataSize)
 {
   if (!dataSize) return;
+  if (m_sharedBuffer) { // the shared buffer must not be modified, so copy it
+    m_buffer=*m_sharedBuffer;
+    m_sharedBuffer.reset();
+  }
   size_t actualSize=m_buffer.size();
   m_buffer.resize(actualSize+size_t(dataSize));
   std::memcpy(&m_buffer[actualSize], data, dataSize);
@@ -70,6 +91,12 @@ STOFFStringStream::STOFFStringStream(const unsigned char *data, const unsigned i
 {
 }
 
+STOFFStringStream::STOFFStringStream(std::shared_ptr<std::vector<unsigned char> const> const &buffer) :
+  librevenge::RVNGInputStream(),
+  m_data(new STOFFStringStreamPrivate(buffer ? buffer : std::make_shared<std::vector<unsigned char> const>()))
+{
+}
+
 STOFFStringStream::~STOFFStringStream()
 {
 }
@@ -88,10 +115,10 @@ const unsigned char *STOFFStringStream::read(unsigned long numBytes, unsigned lo
 
   long numBytesToRead;
 
-  if (static_cast<unsigned long>(m_data->m_offset)+numBytes < m_data->m_buffer.size())
+  if (static_cast<unsigned long>(m_data->m_offset)+numBytes < m_data->buffer().size())
     numBytesToRead = long(numBytes);
   else
-    numBytesToRead = long(m_data->m_buffer.size()) - m_data->m_offset;
+    numBytesToRead = long(m_data->buffer().size()) - m_data->m_offset;
 
   numBytesRead = static_cast<unsigned long>(numBytesToRead); // about as paranoid as we can be..
 
@@ -101,7 +128,7 @@ const unsigned char *STOFFStringStream::read(unsigned long numBytes, unsigned lo
   long oldOffset = m_data->m_offset;
   m_data->m_offset += numBytesToRead;
 
-  return &m_data->m_buffer[size_t(oldOffset)];
+  return &m_data->buffer()[size_t(oldOffset)];
 
 }
 
@@ -118,14 +145,14 @@ int STOFFStringStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
   else if (seekType == librevenge::RVNG_SEEK_SET)
     m_data->m_offset = offset;
   else if (seekType == librevenge::RVNG_SEEK_END)
-    m_data->m_offset = offset+long(m_data->m_buffer.size());
+    m_data->m_offset = offset+long(m_data->buffer().size());
 
   if (m_data->m_offset < 0) {
     m_data->m_offset = 0;
     return -1;
   }
-  if (long(m_data->m_offset) > long(m_data->m_buffer.size())) {
-    m_data->m_offset = long(m_data->m_buffer.size());
+  if (long(m_data->m_offset) > long(m_data->buffer().size())) {
+    m_data->m_offset = long(m_data->buffer().size());
     return -1;
   }
 
@@ -134,7 +161,7 @@ int STOFFStringStream::seek(long offset, librevenge::RVNG_SEEK_TYPE seekType)
 
 bool STOFFStringStream::isEnd()
 {
-  if (!m_data || long(m_data->m_offset) >= long(m_data->m_buffer.size()))
+  if (!m_data || long(m_data->m_offset) >= long(m_data->buffer().size()))
     return true;
 
   return false;
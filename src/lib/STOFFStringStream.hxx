@@ -23,6 +23,7 @@
 #define STOFF_STRING_STREAM_HXX
 
 #include <memory>
+#include <vector>
 
 #include <librevenge-stream/librevenge-stream.h>
 
@@ -38,6 +39,9 @@ class STOFFStringStream final: public librevenge::RVNGInputStream
 public:
   //! constructor
   STOFFStringStream(const unsigned char *data, const unsigned int dataSize);
+  /** constructor: creates a stream which reads buffer without copying it, so that
+      several streams (for instance used by different threads) can share the same data */
+  explicit STOFFStringStream(std::shared_ptr<std::vector<unsigned char> const> const &buffer);
   //! destructor
   ~STOFFStringStream() final;
 
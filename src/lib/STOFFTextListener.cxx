@@ -132,6 +132,8 @@ struct State {
 
   //! a buffer to stored the text
   librevenge::RVNGString m_textBuffer;
+  //! true if the text buffer can contain some consecutive spaces
+  bool m_textBufferHasConsecutiveSpaces;
   //! the number of tabs to add
   int m_numDeferredTabs;
 
@@ -186,6 +188,7 @@ private:
 
 State::State()
   : m_textBuffer("")
+  , m_textBufferHasConsecutiveSpaces(false)
   , m_numDeferredTabs(0)
 
   , m_font()
@@ -295,6 +298,8 @@ void STOFFTextListener::insertChar(uint8_t character)
   }
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (character==' ' && libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, " "))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   m_ps->m_textBuffer.append(char(character));
 }
 
@@ -312,13 +317,26 @@ void STOFFTextListener::insertUnicode(uint32_t val)
 
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (val==0x20 && libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, " "))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   libstoff::appendUnicode(val, m_ps->m_textBuffer);
 }
 
+void STOFFTextListener::insertUnicodeRun(uint32_t const *chars, size_t numChars)
+{
+  if (!chars || !numChars) return;
+  _flushDeferredTabs();
+  if (!m_ps->m_isSpanOpened) _openSpan();
+  if (libstoff::appendUnicodeRun(chars, numChars, m_ps->m_textBuffer))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
+}
+
 void STOFFTextListener::insertUnicodeString(librevenge::RVNGString const &str)
 {
   _flushDeferredTabs();
   if (!m_ps->m_isSpanOpened) _openSpan();
+  if (libstoff::createsConsecutiveSpaces(m_ps->m_textBuffer, str.cstr()))
+    m_ps->m_textBufferHasConsecutiveSpaces=true;
   m_ps->m_textBuffer.append(str);
 }
 
@@ -575,6 +593,7 @@ void STOFFTextListener::_openPageSpan(bool sendHeaderFooters)
 {
   if (m_ps->m_isPageSpanOpened)
     return;
+  updateParseControl();
 
   if (!m_ds->m_isDocumentStarted)
     startDocument();
@@ -1040,6 +1059,12 @@ void STOFFTextListener::_flushText()
 {
   if (m_ps->m_textBuffer.len() == 0) return;
 
+  if (!m_ps->m_textBufferHasConsecutiveSpaces) {
+    m_documentInterface->insertText(m_ps->m_textBuffer);
+    m_ps->m_textBuffer.clear();
+    return;
+  }
+
   // when some many ' ' follows each other, call insertSpace
   librevenge::RVNGString tmpText;
   int numConsecutiveSpaces = 0;
@@ -1062,6 +1087,7 @@ void STOFFTextListener::_flushText()
   }
   m_documentInterface->insertText(tmpText);
   m_ps->m_textBuffer.clear();
+  m_ps->m_textBufferHasConsecutiveSpaces=false;
 }
 
 ///////////////////
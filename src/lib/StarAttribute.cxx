@@ -394,6 +394,27 @@ void StarAttributeItemSet::addTo(StarState &state, std::set<StarAttribute const
   }
 }
 
+void StarAttributeItemSet::updateAnchorIndex(int &index, StarItemPool const *pool, std::set<StarAttribute const *> &done) const
+{
+  if (done.find(this)!=done.end()) {
+    STOFF_DEBUG_MSG(("StarAttributeItemSet::updateAnchorIndex: find a cycle\n"));
+    return;
+  }
+  done.insert(this);
+  StarItemSet finalSet;
+  bool newSet=false;
+  if (pool && !m_itemSet.m_style.empty()) {
+    finalSet=m_itemSet;
+    pool->updateUsingStyles(finalSet);
+    newSet=true;
+  }
+  StarItemSet const &set=newSet ? finalSet : m_itemSet;
+  for (auto const &it : set.m_whichToItemMap) {
+    if (it.second && it.second->m_attribute)
+      it.second->m_attribute->updateAnchorIndex(index, pool, done);
+  }
+}
+
 void StarAttributeItemSet::print(libstoff::DebugStream &o, std::set<StarAttribute const *> &done) const
 {
   if (done.find(this)!=done.end()) {
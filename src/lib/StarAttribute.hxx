@@ -763,6 +763,11 @@ public:
   {
     return false;
   }
+  /** updates index if the attribute defines a "at char" anchor, ie. does what addTo does
+      with the frame's anchor index but without creating a state(internal) */
+  virtual void updateAnchorIndex(int &/*index*/, StarItemPool const */*pool*/, std::set<StarAttribute const *> &/*done*/) const
+  {
+  }
   //! returns the debug name
   std::string const &getDebugName() const
   {
@@ -1045,6 +1050,8 @@ protected:
   void addTo(StarState &state, std::set<StarAttribute const *> &done) const override;
   //! try to send the sone data
   bool send(STOFFListenerPtr &listener, StarState &state, std::set<StarAttribute const *> &done) const override;
+  //! updates the "at char" anchor index
+  void updateAnchorIndex(int &index, StarItemPool const *pool, std::set<StarAttribute const *> &done) const override;
 
   //! copy constructor
   StarAttributeItemSet(StarAttributeItemSet const &) = default;
@@ -275,6 +275,14 @@ bool StarBitmap::readBitmap(StarZone &zone, bool inFileHeader, long lastPos, lib
       return false;
     }
     lastPos=input->tell()+long(codeSize);
+    if (input->skipBinaryData()) {
+      ascFile.addPos(pos);
+      ascFile.addNote(f.str().c_str());
+      ascFile.skipZone(input->tell(),lastPos-1);
+      input->seek(lastPos, librevenge::RVNG_SEEK_SET);
+      if (inFileHeader) type="image/bm";
+      return true;
+    }
 #ifdef USE_ZIP
     ascFile.skipZone(input->tell(),lastPos-1);
     unsigned long readBytes=0;
@@ -648,6 +656,10 @@ bool StarBitmap::readBitmapData(STOFFInputStreamPtr &input, StarBitmapInternal::
     input->seek(lastPos, librevenge::RVNG_SEEK_SET);
     return false;
   }
+  if (input->skipBinaryData()) {
+    input->seek(actPos+long(bitmap.m_height)*long(alignWidth), librevenge::RVNG_SEEK_SET);
+    return true;
+  }
 
   switch (bitmap.m_bitCount) {
   case 1: {
@@ -31,6 +31,7 @@
 * instead of those above.
 */
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -358,7 +359,150 @@ bool Token::addToken(std::vector<std::vector<Token> > &stack, Token const &token
   return true;
 }
 
+//! returns the relative flags of a cell reference
+static STOFFVec3b getRelativeFlags(uint8_t nByte, int version)
+{
+  if (version<0x10)
+    return STOFFVec3b((nByte&3)!=0, ((nByte>>2)&3)!=0, ((nByte>>4)&3)!=0);
+  return STOFFVec3b((nByte&1)!=0, ((nByte>>2)&1)!=0, ((nByte>>4)&1)!=0);
+}
+
+//! appends numBytes bytes of the input to the signature
+static bool appendBytes(STOFFInputStream &input, long numBytes, long lastPos, std::vector<uint8_t> &signature)
+{
+  if (numBytes<0 || input.tell()+numBytes>lastPos) return false;
+  for (long i=0; i<numBytes; ++i) signature.push_back(static_cast<uint8_t>(input.readULong(1)));
+  return true;
+}
+
+//! appends a value stored on numBytes bytes to the signature
+static void appendValue(int value, int numBytes, std::vector<uint8_t> &signature)
+{
+  for (int i=0; i<numBytes; ++i, value>>=8)
+    signature.push_back(static_cast<uint8_t>(value&0xFF));
+}
+
+/* appends the signature of a token, ie. its bytes where the relative
+   cell coordinates are replaced by their offsets to cellPos, must be
+   kept in sync with StarCellFormula::readSCToken */
+static bool appendTokenSignature(STOFFInputStream &input, int version, long lastPos, STOFFVec2i const &cellPos, std::vector<uint8_t> &signature)
+{
+  if (!appendBytes(input, 2, lastPos, signature) || input.tell()+1>lastPos) return false;
+  auto type=static_cast<uint8_t>(input.readULong(1));
+  signature.push_back(type);
+  switch (type) {
+  case 0:
+    return appendBytes(input, 1, lastPos, signature);
+  case 1:
+    return appendBytes(input, 8, lastPos, signature);
+  case 3:
+  case 4:
+    for (int c=0; c<(type==3 ? 1 : 2); ++c) {
+      if (input.tell()+7>lastPos) return false;
+      auto col=int(input.readLong(2));
+      auto row=int(input.readLong(2));
+      auto tab=int(input.readLong(2));
+      auto nByte=static_cast<uint8_t>(input.readULong(1));
+      STOFFVec3b relative=getRelativeFlags(nByte, version);
+      appendValue(relative[0] ? col-cellPos[0] : col, 4, signature);
+      appendValue(relative[1] ? row-cellPos[1] : row, 4, signature);
+      appendValue(tab, 2, signature);
+      signature.push_back(nByte);
+    }
+    return true;
+  case 6:
+    return appendBytes(input, 2, lastPos, signature);
+  case 7: {
+    if (input.tell()+1>lastPos) return false;
+    auto nByte=static_cast<uint8_t>(input.readULong(1));
+    signature.push_back(nByte);
+    return appendBytes(input, 2*long(nByte), lastPos, signature);
+  }
+  case 0x70:
+  case 0x71:
+    return true;
+  case 8:
+    if (!appendBytes(input, 1, lastPos, signature)) return false;
+    STOFF_FALLTHROUGH;
+  case 2:
+  default: {
+    if (input.tell()+1>lastPos) return false;
+    auto nBytes=static_cast<uint8_t>(input.readULong(1));
+    signature.push_back(nBytes);
+    return appendBytes(input, long(nBytes), lastPos, signature);
+  }
+  }
+}
+
+/* try to compute the signature of a formula, must be kept in sync
+   with StarCellFormula::readSCFormula */
+static bool getFormulaSignature(StarZone &zone, int version, long lastPos, STOFFVec2i const &cellPos, std::vector<uint8_t> &signature)
+{
+  STOFFInputStream &input=*zone.input();
+  signature.clear();
+  signature.push_back(static_cast<uint8_t>(zone.getEncoding()));
+  if (input.tell()+1>lastPos) return false;
+  auto fFlags=static_cast<uint8_t>(input.readULong(1));
+  signature.push_back(fFlags);
+  if (!appendBytes(input, long(fFlags&0xf)+1+((fFlags&0x10) ? 2 : 0)+((fFlags&0x20) ? 2 : 0), lastPos, signature))
+    return false;
+  if (fFlags&0x40) {
+    if (input.tell()+2>lastPos) return false;
+    auto nLen=int(input.readULong(2));
+    appendValue(nLen, 2, signature);
+    for (int tok=0; tok<nLen; ++tok) {
+      if (!appendTokenSignature(input, version, lastPos, cellPos, signature))
+        return false;
+    }
+  }
+  if (fFlags&0x80) {
+    if (input.tell()+2>lastPos) return false;
+    auto nRPN=int(input.readULong(2));
+    appendValue(nRPN, 2, signature);
+    for (int rpn=0; rpn<nRPN; ++rpn) {
+      if (input.tell()+1>lastPos) return false;
+      auto b1=static_cast<uint8_t>(input.readULong(1));
+      signature.push_back(b1);
+      if (b1==0xff) {
+        if (!appendTokenSignature(input, version, lastPos, cellPos, signature))
+          return false;
+      }
+      else if ((b1&0x40) && !appendBytes(input, 1, lastPos, signature))
+        return false;
+    }
+  }
+  return true;
 }
+
+//! moves the relative cell's positions of a formula by decal
+static void moveRelativePositions(std::vector<STOFFCellContent::FormulaInstruction> &formula, STOFFVec2i const &decal)
+{
+  for (auto &instr : formula) {
+    if (instr.m_type!=STOFFCellContent::FormulaInstruction::F_Cell &&
+        instr.m_type!=STOFFCellContent::FormulaInstruction::F_CellList)
+      continue;
+    int const numPos=instr.m_type==STOFFCellContent::FormulaInstruction::F_Cell ? 1 : 2;
+    for (int p=0; p<numPos; ++p) {
+      for (int c=0; c<2; ++c) {
+        if (instr.m_positionRelative[p][c])
+          instr.m_position[p][c]+=decal[c];
+      }
+    }
+  }
+}
+
+}
+
+////////////////////////////////////////////////////////////
+// formula cache
+////////////////////////////////////////////////////////////
+StarCellFormula::FormulaCache::~FormulaCache()
+{
+  if (m_numHits) {
+    STOFF_DEBUG_MSG(("StarCellFormula::FormulaCache: %ld formulas retrieved from the cache, %ld decoded\n", m_numHits, m_numMisses));
+  }
+}
+
 ////////////////////////////////////////////////////////////
 // main zone
 ////////////////////////////////////////////////////////////
@@ -371,10 +515,9 @@ void StarCellFormula::updateFormula(STOFFCellContent &content, std::vector<libre
         form.m_sheetId<0 || form.m_sheetId==sheetId)
       continue;
     if (form.m_sheetId>=numNames) {
-      static bool first=true;
-      if (first) {
+      static std::atomic<bool> first(true);
+      if (first.exchange(false)) {
         STOFF_DEBUG_MSG(("StarCellFormula::updateFormula: some sheetId are bad\n"));
-        first=false;
       }
       continue;
     }
@@ -516,10 +659,9 @@ bool StarCellFormula::readSCFormula(StarZone &zone, STOFFCellContent &content, i
 #endif
   }
   if (!formulaSet) {
-    static bool first=true;
-    if (first) {
+    static std::atomic<bool> first(true);
+    if (first.exchange(false)) {
       STOFF_DEBUG_MSG(("StarCellFormula::readSCFormula: can not reconstruct some formula\n"));
-      first=false;
     }
     f << "###";
   }
@@ -528,6 +670,42 @@ bool StarCellFormula::readSCFormula(StarZone &zone, STOFFCellContent &content, i
   return ok;
 }
 
+bool StarCellFormula::readSCFormula(StarZone &zone, STOFFCellContent &content, int version, long lastPos,
+                                    STOFFVec2i const &cellPos, FormulaCache &cache)
+{
+  STOFFInputStreamPtr input=zone.input();
+  long pos=input->tell();
+  std::vector<uint8_t> signature;
+  bool hasSignature=StarCellFormulaInternal::getFormulaSignature(zone, version, lastPos, cellPos, signature);
+  long endPos=input->tell();
+  if (hasSignature) {
+    auto it=cache.m_signatureToFormulaMap.find(signature);
+    if (it!=cache.m_signatureToFormulaMap.end()) {
+      ++cache.m_numHits;
+      content.m_formula=it->second;
+      StarCellFormulaInternal::moveRelativePositions(content.m_formula, cellPos);
+      content.m_contentType=STOFFCellContent::C_FORMULA;
+      libstoff::DebugFile &ascFile=zone.ascii();
+      libstoff::DebugStream f;
+      f << "Entries(SCFormula)[" << zone.getRecordLevel() << "]:cached,";
+      ascFile.addPos(pos);
+      ascFile.addNote(f.str().c_str());
+      return true;
+    }
+  }
+  input->seek(pos, librevenge::RVNG_SEEK_SET);
+  if (!readSCFormula(zone, content, version, lastPos))
+    return false;
+  // only store the formulas which can be fully retrieved from the cache
+  if (!hasSignature || input->tell()!=endPos || content.m_contentType!=STOFFCellContent::C_FORMULA || content.m_formula.empty())
+    return true;
+  ++cache.m_numMisses;
+  auto &formula=cache.m_signatureToFormulaMap[signature];
+  formula=content.m_formula;
+  StarCellFormulaInternal::moveRelativePositions(formula, STOFFVec2i(-cellPos[0], -cellPos[1]));
+  return true;
+}
+
 bool StarCellFormula::readSCFormula3(StarZone &zone, STOFFCellContent &content, int /*version*/, long lastPos)
 {
   STOFFInputStreamPtr input=zone.input();
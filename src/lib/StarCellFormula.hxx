@@ -38,6 +38,7 @@
 #ifndef STAR_CELL_FORMULA
 #  define STAR_CELL_FORMULA
 
+#include <map>
 #include <vector>
 
 #include "libstaroffice_internal.hxx"
@@ -57,12 +58,38 @@ struct Token;
 class StarCellFormula
 {
 public:
+  /** \brief a cache used to decode only once the formulas which are repeated in a sheet
+
+      The formulas are indexed by their byte signature where the relative
+      cell coordinates are replaced by their offsets to the formula cell,
+      so that a filled-down formula is decoded only once.
+   */
+  struct FormulaCache {
+    //! constructor
+    FormulaCache()
+      : m_signatureToFormulaMap()
+      , m_numHits(0)
+      , m_numMisses(0)
+    {
+    }
+    //! destructor
+    ~FormulaCache();
+    //! the map signature to formula, the relative cell's positions being stored as offsets
+    std::map<std::vector<uint8_t>, std::vector<STOFFCellContent::FormulaInstruction> > m_signatureToFormulaMap;
+    //! the number of formulas retrieved from the cache
+    long m_numHits;
+    //! the number of formulas decoded and stored in the cache
+    long m_numMisses;
+  };
   //! constructor
   StarCellFormula() {}
   //! destructor
   ~StarCellFormula() {}
   //! try to read a formula
   static bool readSCFormula(StarZone &zone, STOFFCellContent &content, int version, long lastPos);
+  //! try to read a formula of the cell cellPos, using cache to retrieve the already decoded formulas
+  static bool readSCFormula(StarZone &zone, STOFFCellContent &content, int version, long lastPos,
+                            STOFFVec2i const &cellPos, FormulaCache &cache);
   //! try to read a formula(v3)
   static bool readSCFormula3(StarZone &zone, STOFFCellContent &content, int version, long lastPos);
   //! update the different formula(knowing the list of sheet names and the cell's sheetId)
@@ -209,7 +209,11 @@ STOFFInputStreamPtr StarEncryption::decodeStream(STOFFInputStreamPtr input, uint
   std::shared_ptr<STOFFStringStream> stream(new STOFFStringStream(reinterpret_cast<const unsigned char *>(finalData.get()),static_cast<unsigned int>(dataSize)));
   if (!stream) return res;
   res.reset(new STOFFInputStream(stream, input->readInverted()));
-  if (res) res->seek(0, librevenge::RVNG_SEEK_SET);
+  if (!res) return res;
+  res->setSkipBinaryData(input->skipBinaryData());
+  res->setRecordEmbeddedObjects(input->recordEmbeddedObjects());
+  res->setParseControl(input->getParseControl());
+  res->seek(0, librevenge::RVNG_SEEK_SET);
   return res;
 }
 
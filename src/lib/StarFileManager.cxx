@@ -31,12 +31,15 @@
 * instead of those above.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 #include <librevenge/librevenge.h>
 
@@ -159,7 +162,7 @@ struct SfxMultiRecord {
     return true;
   }
   //! try to close a zone
-  void close(std::string const &wh)
+  void close(char const *wh)
   {
     if (!m_zoneOpened) {
       STOFF_DEBUG_MSG(("StarFileManagerInternal::SfxMultiRecord::close: can not find any opened zone\n"));
@@ -181,7 +184,7 @@ struct SfxMultiRecord {
     return !m_zoneOpened ? -1 : int(m_headerTag);
   }
   //! try to go to the new content positon
-  bool getNewContent(std::string const &wh)
+  bool getNewContent(char const *wh)
   {
     // SfxMultiRecordReader::GetContent
     long newPos=getLastContentPosition();
@@ -305,7 +308,83 @@ bool StarFileManager::readOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser
     STOFF_DEBUG_MSG(("StarFileManager::readOLEDirectory: can not read an ole\n"));
     return false;
   }
+  if (ole->m_decoded) {
+    // the result is given once, the following calls decode again the directory
+    image=ole->m_decodedImage;
+    res=ole->m_decodedObject;
+    ole->m_decoded=false;
+    ole->m_decodedImage=STOFFEmbeddedObject();
+    ole->m_decodedObject.reset();
+    return ole->m_decodedOk;
+  }
   ole->m_inUse=true;
+  return decodeOLEDirectory(oleParser, ole, image, res);
+}
+
+void StarFileManager::decodeOLEDirectories(std::shared_ptr<STOFFOLEParser> oleParser)
+{
+  if (!oleParser) return;
+  /* look for the embedded objects stored in a main directory which are not already read
+     and which are referenced by the objects already read (the objects of the draw pages
+     which are not read yet will be decoded when needed) */
+  std::vector<std::shared_ptr<STOFFOLEParser::OleDirectory> > directories;
+  for (auto const &dir : oleParser->getDirectoryList()) {
+    if (!dir || dir->m_dir.empty() || dir->m_dir.find('/')!=std::string::npos || dir->m_inUse || dir->m_parsed || !dir->m_referenced)
+      continue;
+    switch (dir->m_kind) {
+    case STOFFDocument::STOFF_K_CHART:
+    case STOFFDocument::STOFF_K_DRAW:
+    case STOFFDocument::STOFF_K_MATH:
+    case STOFFDocument::STOFF_K_SPREADSHEET:
+    case STOFFDocument::STOFF_K_TEXT:
+      directories.push_back(dir);
+      break;
+    case STOFFDocument::STOFF_K_BITMAP:
+    case STOFFDocument::STOFF_K_DATABASE:
+    case STOFFDocument::STOFF_K_GRAPHIC:
+    case STOFFDocument::STOFF_K_PRESENTATION:
+    case STOFFDocument::STOFF_K_UNKNOWN:
+#if !defined(__clang__)
+    default:
+#endif
+      break;
+    }
+  }
+  auto numThreads=std::min(size_t(std::thread::hardware_concurrency()), directories.size());
+  if (numThreads<=1)
+    return;
+  // each directory is decoded in its own StarObject, the next directory to decode being given by nextDirectory
+  std::atomic<size_t> nextDirectory(0);
+  auto decode=[&oleParser, &directories, &nextDirectory]() {
+    for (size_t d=nextDirectory++; d<directories.size(); d=nextDirectory++) {
+      auto &dir=*directories[d];
+      dir.m_inUse=true;
+      try {
+        dir.m_decodedOk=decodeOLEDirectory(oleParser, directories[d], dir.m_decodedImage, dir.m_decodedObject);
+      }
+      catch (...) {
+        dir.m_decodedOk=false;
+      }
+      dir.m_decoded=true;
+      dir.m_inUse=false;
+    }
+  };
+  std::vector<std::thread> threads;
+  try {
+    for (size_t i=1; i<numThreads; ++i)
+      threads.push_back(std::thread(decode));
+  }
+  catch (...) {
+    STOFF_DEBUG_MSG(("StarFileManager::decodeOLEDirectories: can not create some threads\n"));
+  }
+  decode();
+  for (auto &thread : threads)
+    thread.join();
+}
+
+bool StarFileManager::decodeOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> ole, STOFFEmbeddedObject &image, std::shared_ptr<StarObject> &res)
+{
+  image=STOFFEmbeddedObject();
   StarObject object(nullptr, oleParser, ole); // do we need password here ?
   if (object.getDocumentKind()==STOFFDocument::STOFF_K_CHART) {
     auto chart=std::make_shared<StarObjectChart>(object, false);
@@ -317,7 +396,7 @@ bool StarFileManager::readOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser
     StarObjectDraw draw(object, false);
     ole->m_parsed=true;
     if (draw.parse()) {
-      STOFFGraphicEncoder graphicEncoder;
+      STOFFGraphicEncoder graphicEncoder(ole->m_input && ole->m_input->recordEmbeddedObjects());
       std::vector<STOFFPageSpan> pageList;
       int numPages;
       if (!draw.updatePageSpans(pageList, numPages)) {
@@ -342,7 +421,7 @@ bool StarFileManager::readOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser
     StarObjectSpreadsheet spreadsheet(object, false);
     ole->m_parsed=true;
     if (spreadsheet.parse()) {
-      STOFFSpreadsheetEncoder spreadsheetEncoder;
+      STOFFSpreadsheetEncoder spreadsheetEncoder(ole->m_input && ole->m_input->recordEmbeddedObjects());
       std::vector<STOFFPageSpan> pageList;
       int numPages;
       if (!spreadsheet.updatePageSpans(pageList, numPages)) {
@@ -957,6 +1036,16 @@ bool StarFileManager::readJobSetUp(StarZone &zone, bool useJobLen)
 
 bool StarFileManager::readSVGDI(StarZone &zone)
 {
+  librevenge::RVNGBinaryData bitmapData;
+  std::string bitmapType;
+  return readSVGDI(zone, bitmapData, bitmapType);
+}
+
+bool StarFileManager::readSVGDI(StarZone &zone, librevenge::RVNGBinaryData &bitmapData, std::string &bitmapType)
+{
+  bitmapData.clear();
+  bitmapType="";
+  long bitmapArea=0;
   STOFFInputStreamPtr input=zone.input();
   libstoff::DebugFile &ascFile=zone.ascii();
   long pos=input->tell();
@@ -1202,8 +1291,17 @@ bool StarFileManager::readSVGDI(StarZone &zone)
       StarBitmap bitmap;
       librevenge::RVNGBinaryData data;
       std::string dataType;
-      if (!bitmap.readBitmap(zone, false, endDataPos, data, dataType))
+      if (!bitmap.readBitmap(zone, false, endDataPos, data, dataType)) {
         f << "###bitmap,";
+        break;
+      }
+      auto bitmapSize=bitmap.getBitmapSize();
+      long area=long(bitmapSize[0])*long(bitmapSize[1]);
+      if (area>bitmapArea && bitmap.getData(data, dataType)) {
+        bitmapArea=area;
+        bitmapData=data;
+        bitmapType=dataType;
+      }
       break;
     }
     case 19:
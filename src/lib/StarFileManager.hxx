@@ -71,8 +71,13 @@ public:
   //! check for unparsed zone
   static void checkUnparsed(STOFFInputStreamPtr input, std::shared_ptr<STOFFOLEParser> oleParser, char const *password);
 
-  //! try to read a Ole directory
+  //! try to read a Ole directory (or retrieves the result of decodeOLEDirectories)
   static bool readOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> ole, STOFFEmbeddedObject &image, std::shared_ptr<StarObject> &object);
+  /** try to decode concurrently the embedded objects which are stored in the main directories
+      and which are referenced by the objects already read.
+
+      \note the results are stored in the directories and retrieved once by readOLEDirectory */
+  static void decodeOLEDirectories(std::shared_ptr<STOFFOLEParser> oleParser);
 
   //! try to read a image zone: "StarImageDocument" or "StarImageDocument 4.0
   static bool readImageDocument(STOFFInputStreamPtr input, librevenge::RVNGBinaryData &data, std::string const &fileName);
@@ -95,8 +100,12 @@ public:
   static bool readFont(StarZone &zone);
   //! try to read a SVGDI object
   static bool readSVGDI(StarZone &zone);
+  //! try to read a SVGDI object and to retrieve its biggest bitmap (if any)
+  static bool readSVGDI(StarZone &zone, librevenge::RVNGBinaryData &bitmapData, std::string &bitmapType);
 
 protected:
+  //! try to decode a Ole directory
+  static bool decodeOLEDirectory(std::shared_ptr<STOFFOLEParser> oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> ole, STOFFEmbeddedObject &image, std::shared_ptr<StarObject> &object);
 
   //
   // data
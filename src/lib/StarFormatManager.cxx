@@ -35,6 +35,7 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <set>
 #include <sstream>
 
 #include <librevenge/librevenge.h>
@@ -73,6 +74,18 @@ void FormatDef::updateState(StarState &state) const
   }
 }
 
+int FormatDef::getAnchorIndex(StarItemPool const *pool) const
+{
+  int index=-1;
+  for (auto const &attr : m_attributeList) {
+    if (!attr.m_attribute)
+      continue;
+    std::set<StarAttribute const *> done;
+    attr.m_attribute->updateAnchorIndex(index, pool, done);
+  }
+  return index;
+}
+
 bool FormatDef::send(STOFFListenerPtr listener, StarState &state) const
 {
   if (!listener) {
@@ -44,9 +44,9 @@
 #include "STOFFEntry.hxx"
 #include "STOFFInputStream.hxx"
 
+#include "StarState.hxx"
 #include "StarWriterStruct.hxx"
 
-class StarState;
 class StarObject;
 
 namespace StarFormatManagerInternal
@@ -62,6 +62,10 @@ struct FormatDef {
   ~FormatDef();
   //! try to update the state
   void updateState(StarState &state) const;
+  /** returns the "at char" anchor index (or -1)
+
+      \note the attributes are scanned directly, no state is created */
+  int getAnchorIndex(StarItemPool const *pool) const;
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const;
   //! debug function to print the data
@@ -249,86 +249,86 @@ StarGAttributeItemSet::~StarGAttributeItemSet()
 void StarGAttributeBool::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==XATTR_LINESTARTCENTER)
-    state.m_graphic.m_propertyList.insert("draw:marker-start-center", m_value);
+    state.m_graphic.edit().m_propertyList.insert("draw:marker-start-center", m_value);
   else if (m_type==XATTR_LINEENDCENTER)
-    state.m_graphic.m_propertyList.insert("draw:marker-end-center", m_value);
+    state.m_graphic.edit().m_propertyList.insert("draw:marker-end-center", m_value);
   else if (m_type==XATTR_FILLBMP_TILE && m_value)
-    state.m_graphic.m_propertyList.insert("style:repeat", "repeat");
+    state.m_graphic.edit().m_propertyList.insert("style:repeat", "repeat");
   else if (m_type==XATTR_FILLBMP_STRETCH && m_value)
-    state.m_graphic.m_propertyList.insert("style:repeat", "stretch");
+    state.m_graphic.edit().m_propertyList.insert("style:repeat", "stretch");
   else if (m_type==XATTR_FILLBACKGROUND)
-    state.m_graphic.m_hasBackground=m_value;
+    state.m_graphic.edit().m_hasBackground=m_value;
   else if (m_type==StarAttribute::SDRATTR_SHADOW)
-    state.m_graphic.m_propertyList.insert("draw:shadow", m_value ? "visible" : "hidden");
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow", m_value ? "visible" : "hidden");
   else if (m_type==SDRATTR_TEXT_AUTOGROWHEIGHT)
-    state.m_graphic.m_propertyList.insert("draw:auto-grow-height", m_value);
+    state.m_graphic.edit().m_propertyList.insert("draw:auto-grow-height", m_value);
   else if (m_type==SDRATTR_TEXT_AUTOGROWWIDTH)
-    state.m_graphic.m_propertyList.insert("draw:auto-grow-width", m_value);
+    state.m_graphic.edit().m_propertyList.insert("draw:auto-grow-width", m_value);
   else if (m_type==SDRATTR_TEXT_ANISTARTINSIDE)
-    state.m_graphic.m_propertyList.insert("text:animation-start-inside", m_value);
+    state.m_graphic.edit().m_propertyList.insert("text:animation-start-inside", m_value);
   else if (m_type==SDRATTR_TEXT_ANISTOPINSIDE)
-    state.m_graphic.m_propertyList.insert("text:animation-stop-inside", m_value);
+    state.m_graphic.edit().m_propertyList.insert("text:animation-stop-inside", m_value);
   else if (m_type==SDRATTR_TEXT_CONTOURFRAME) // checkme
-    state.m_graphic.m_propertyList.insert("style:wrap-contour", m_value);
+    state.m_graphic.edit().m_propertyList.insert("style:wrap-contour", m_value);
   else if (m_type==SDRATTR_OBJMOVEPROTECT)
-    state.m_graphic.m_protections[0]=m_value;
+    state.m_graphic.edit().m_protections[0]=m_value;
   else if (m_type==SDRATTR_OBJSIZEPROTECT)
-    state.m_graphic.m_protections[1]=m_value;
+    state.m_graphic.edit().m_protections[1]=m_value;
   else if (m_type==SDRATTR_OBJPRINTABLE)
-    state.m_graphic.m_protections[2]=!m_value;
+    state.m_graphic.edit().m_protections[2]=!m_value;
   else if (m_type==SDRATTR_MEASUREBELOWREFEDGE)
-    state.m_graphic.m_propertyList.insert("draw:placing", m_value ? "below" : "above");
+    state.m_graphic.edit().m_propertyList.insert("draw:placing", m_value ? "below" : "above");
   else if (m_type==SDRATTR_MEASURESHOWUNIT)
-    state.m_graphic.m_propertyList.insert("draw:show-unit", m_value);
+    state.m_graphic.edit().m_propertyList.insert("draw:show-unit", m_value);
   else if (m_type==SDRATTR_GRAFINVERT)
-    state.m_graphic.m_propertyList.insert("draw:color-inversion", m_value);
+    state.m_graphic.edit().m_propertyList.insert("draw:color-inversion", m_value);
   // TODO: XATTR_FILLBMP_SIZELOG
 }
 
 void StarGAttributeInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==XATTR_LINEWIDTH)
-    state.m_graphic.m_propertyList.insert("svg:stroke-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("svg:stroke-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
   else if (m_type==XATTR_LINESTARTWIDTH)
-    state.m_graphic.m_propertyList.insert("draw:marker-start-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:marker-start-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
   else if (m_type==XATTR_LINEENDWIDTH)
-    state.m_graphic.m_propertyList.insert("draw:marker-end-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:marker-end-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
   else if (m_type==XATTR_FILLBMP_SIZEX)
-    state.m_graphic.m_propertyList.insert("draw:fill-image-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:fill-image-width", state.convertInPoint(m_value),librevenge::RVNG_POINT);
   else if (m_type==XATTR_FILLBMP_SIZEY)
-    state.m_graphic.m_propertyList.insert("draw:fill-image-height", state.convertInPoint(m_value),librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:fill-image-height", state.convertInPoint(m_value),librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_SHADOWXDIST)
-    state.m_graphic.m_propertyList.insert("draw:shadow-offset-x", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-offset-x", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_SHADOWYDIST)
-    state.m_graphic.m_propertyList.insert("draw:shadow-offset-y", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-offset-y", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_TEXT_MAXFRAMEHEIGHT)
-    state.m_graphic.m_propertyList.insert("fo:max-height", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("fo:max-height", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_TEXT_MINFRAMEHEIGHT) // checkme
-    state.m_graphic.m_propertyList.insert("fo:min-height", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("fo:min-height", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_TEXT_MAXFRAMEWIDTH)
-    state.m_graphic.m_propertyList.insert("fo:max-width", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("fo:max-width", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_TEXT_MINFRAMEWIDTH) // checkme
-    state.m_graphic.m_propertyList.insert("fo:min-width", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("fo:min-width", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_CIRCSTARTANGLE)
-    state.m_graphic.m_propertyList.insert("draw:start-angle", double(m_value)/100.,  librevenge::RVNG_GENERIC);
+    state.m_graphic.edit().m_propertyList.insert("draw:start-angle", double(m_value)/100.,  librevenge::RVNG_GENERIC);
   else if (m_type==SDRATTR_CIRCENDANGLE)
-    state.m_graphic.m_propertyList.insert("draw:end-angle", double(m_value)/100.,  librevenge::RVNG_GENERIC);
+    state.m_graphic.edit().m_propertyList.insert("draw:end-angle", double(m_value)/100.,  librevenge::RVNG_GENERIC);
   else if (m_type==SDRATTR_MEASURELINEDIST)
-    state.m_graphic.m_propertyList.insert("draw:line-distance", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:line-distance", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_MEASUREOVERHANG)
-    state.m_graphic.m_propertyList.insert("draw:guide-overhang", state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:guide-overhang", state.convertInPoint(m_value), librevenge::RVNG_POINT);
   else if (m_type==SDRATTR_GRAFRED)
-    state.m_graphic.m_propertyList.insert("draw:red", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:red", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_GRAFGREEN)
-    state.m_graphic.m_propertyList.insert("draw:green", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:green", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_GRAFBLUE)
-    state.m_graphic.m_propertyList.insert("draw:blue", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:blue", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_GRAFLUMINANCE)
-    state.m_graphic.m_propertyList.insert("draw:luminance", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:luminance", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_GRAFCONTRAST)
-    state.m_graphic.m_propertyList.insert("draw:contrast", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:contrast", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_ECKENRADIUS)
-    state.m_graphic.m_propertyList.insert("draw:corner-radius", state.convertInPoint(m_value),librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:corner-radius", state.convertInPoint(m_value),librevenge::RVNG_POINT);
 }
 
 void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
@@ -336,7 +336,7 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   if (m_type==XATTR_LINESTYLE) {
     if (m_value<=2) {
       char const *wh[]= {"none", "solid", "dash"};
-      state.m_graphic.m_propertyList.insert("draw:stroke", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:stroke", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown line style %d\n", int(m_value)));
@@ -345,20 +345,20 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==XATTR_FILLSTYLE) {
     if (m_value<=4) {
       char const *wh[]= {"none", "solid", "gradient", "hatch", "bitmap"};
-      state.m_graphic.m_propertyList.insert("draw:fill", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:fill", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown fill style %d\n", int(m_value)));
     }
   }
   else if (m_type==XATTR_LINETRANSPARENCE)
-    state.m_graphic.m_propertyList.insert("svg:stroke-opacity", 1-double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("svg:stroke-opacity", 1-double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==XATTR_FILLTRANSPARENCE)
-    state.m_graphic.m_propertyList.insert("draw:opacity", 1-double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:opacity", 1-double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==XATTR_LINEJOINT) {
     if (m_value<=4) {
       char const *wh[]= {"none", "middle", "bevel", "miter", "round"};
-      state.m_graphic.m_propertyList.insert("draw:stroke-linejoin", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:stroke-linejoin", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown line join %d\n", int(m_value)));
@@ -367,7 +367,7 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==XATTR_FILLBMP_POS) {
     if (m_value<9) {
       char const *wh[]= {"top-left", "top", "top-right", "left", "center", "right", "bottom-left", "bottom", "bottom-right"};
-      state.m_graphic.m_propertyList.insert("draw:fill-image-ref-point", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:fill-image-ref-point", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown bmp position %d\n", int(m_value)));
@@ -375,30 +375,30 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   }
   // CHECKME: from here never seen
   else if (m_type==XATTR_GRADIENTSTEPCOUNT)
-    state.m_graphic.m_propertyList.insert("draw:gradient-step-count", m_value, librevenge::RVNG_GENERIC);
+    state.m_graphic.edit().m_propertyList.insert("draw:gradient-step-count", m_value, librevenge::RVNG_GENERIC);
   else if (m_type==XATTR_FILLBMP_POSOFFSETX)
-    state.m_graphic.m_propertyList.insert("draw:fill-image-ref-point-x", double(m_value)/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:fill-image-ref-point-x", double(m_value)/100, librevenge::RVNG_PERCENT);
   else if (m_type==XATTR_FILLBMP_POSOFFSETY)
-    state.m_graphic.m_propertyList.insert("draw:fill-image-ref-point-y", double(m_value)/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:fill-image-ref-point-y", double(m_value)/100, librevenge::RVNG_PERCENT);
   else if (m_type==XATTR_FILLBMP_TILEOFFSETX || m_type==XATTR_FILLBMP_TILEOFFSETY) {
     std::stringstream s;
     s << m_value << "% " << (m_type==XATTR_FILLBMP_TILEOFFSETX ? "horizontal" : "vertical");
-    state.m_graphic.m_propertyList.insert("draw:tile-repeat-offset", s.str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("draw:tile-repeat-offset", s.str().c_str());
   }
   else if (m_type==SDRATTR_SHADOWTRANSPARENCE)
-    state.m_graphic.m_propertyList.insert("draw:shadow-opacity", 1.0-double(m_value)/255., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-opacity", 1.0-double(m_value)/255., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_TEXT_LEFTDIST || m_type==SDRATTR_TEXT_RIGHTDIST ||
            m_type==SDRATTR_TEXT_UPPERDIST || m_type==SDRATTR_TEXT_LOWERDIST) {
     char const *wh[] = {"left", "right", "top", "bottom"};
-    state.m_graphic.m_propertyList.insert((std::string("padding-")+wh[(m_type-SDRATTR_TEXT_LEFTDIST)]).c_str(), state.convertInPoint(m_value), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert((std::string("padding-")+wh[(m_type-SDRATTR_TEXT_LEFTDIST)]).c_str(), state.convertInPoint(m_value), librevenge::RVNG_POINT);
   }
   else if (m_type==SDRATTR_TEXT_FITTOSIZE)
     // TODO: 0: none, 1: proportional, allline, autofit
-    state.m_graphic.m_propertyList.insert("draw:fit-to-size", m_value!=0);
+    state.m_graphic.edit().m_propertyList.insert("draw:fit-to-size", m_value!=0);
   else if (m_type==SDRATTR_TEXT_HORZADJUST) {
     if (m_value<4) {
       char const *wh[]= {"left", "center", "right", "justify"};
-      state.m_graphic.m_propertyList.insert("draw:textarea-horizontal-align", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:textarea-horizontal-align", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown text horizontal position %d\n", int(m_value)));
@@ -407,25 +407,25 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==SDRATTR_TEXT_VERTADJUST) {
     if (m_value<4) {
       char const *wh[]= {"top", "middle", "bottom", "justify"};
-      state.m_graphic.m_propertyList.insert("draw:textarea-vertical-align", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:textarea-vertical-align", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown text vertical position %d\n", int(m_value)));
     }
   }
   else if (m_type==SDRATTR_TEXT_ANIAMOUNT) // unsure
-    state.m_graphic.m_propertyList.insert("text:animation-steps", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("text:animation-steps", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_TEXT_ANICOUNT)
-    state.m_graphic.m_propertyList.insert("text:animation-repeat", int(m_value));
+    state.m_graphic.edit().m_propertyList.insert("text:animation-repeat", int(m_value));
   else if (m_type==SDRATTR_TEXT_ANIDELAY) { // check unit
     librevenge::RVNGString delay;
     delay.sprintf("PT%fS", double(m_value));
-    state.m_graphic.m_propertyList.insert("text:animation-delay", delay);
+    state.m_graphic.edit().m_propertyList.insert("text:animation-delay", delay);
   }
   else if (m_type==SDRATTR_TEXT_ANIDIRECTION) {
     if (m_value<4) {
       char const *wh[]= {"left", "right", "up", "down"};
-      state.m_graphic.m_propertyList.insert("text:animation-direction", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("text:animation-direction", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown animation direction %d\n", int(m_value)));
@@ -434,12 +434,12 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==SDRATTR_TEXT_ANIKIND) {
     if (m_value<5) {
       char const *wh[]= {"none", "none" /*blink*/, "scroll", "alternate", "slide"};
-      state.m_graphic.m_propertyList.insert("text:animation", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("text:animation", wh[m_value]);
       if (m_value) {
-        if (!state.m_graphic.m_propertyList["text:animation-direction"])
-          state.m_graphic.m_propertyList.insert("text:animation-direction", "left");
-        if (!state.m_graphic.m_propertyList["text:animation-steps"])
-          state.m_graphic.m_propertyList.insert("text:animation-steps", 0.02, librevenge::RVNG_PERCENT);
+        if (!state.m_graphic.get().m_propertyList["text:animation-direction"])
+          state.m_graphic.edit().m_propertyList.insert("text:animation-direction", "left");
+        if (!state.m_graphic.get().m_propertyList["text:animation-steps"])
+          state.m_graphic.edit().m_propertyList.insert("text:animation-steps", 0.02, librevenge::RVNG_PERCENT);
       }
     }
     else {
@@ -449,20 +449,20 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
   else if (m_type==SDRATTR_CIRCKIND) {
     if (m_value<4) {
       char const *wh[]= {"full", "section", "cut", "arc"};
-      state.m_graphic.m_propertyList.insert("draw:kind", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:kind", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown circle kind %d\n", int(m_value)));
     }
   }
   else if (m_type==SDRATTR_GRAFGAMMA)
-    state.m_graphic.m_propertyList.insert("draw:gamma", double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:gamma", double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_GRAFTRANSPARENCE)
-    state.m_graphic.m_propertyList.insert("draw:opacity", 1.0-double(m_value)/100., librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:opacity", 1.0-double(m_value)/100., librevenge::RVNG_PERCENT);
   else if (m_type==SDRATTR_GRAFMODE) {
     if (m_value<4) {
       char const *wh[]= {"standard", "greyscale", "mono", "watermark"};
-      state.m_graphic.m_propertyList.insert("draw:color-mode", wh[m_value]);
+      state.m_graphic.edit().m_propertyList.insert("draw:color-mode", wh[m_value]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeUInt::addTo: unknown graf color mode %d\n", int(m_value)));
@@ -473,7 +473,7 @@ void StarGAttributeUInt::addTo(StarState &state, std::set<StarAttribute const *>
 void StarGAttributeVoid::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==StarAttribute::SDRATTR_SHADOW3D)
-    state.m_graphic.m_propertyList.insert("dr3d:shadow", "visible");
+    state.m_graphic.edit().m_propertyList.insert("dr3d:shadow", "visible");
   // also SDRATTR_SHADOWPERSP, ok to ignore ?
 }
 
@@ -887,12 +887,12 @@ void StarGAttributeCrop::addTo(StarState &state, std::set<StarAttribute const *>
 {
   if (m_type==SDRATTR_GRAFCROP) {
     if (m_leftTop==STOFFVec2i(0,0) && m_rightBottom==STOFFVec2i(0,0))
-      state.m_graphic.m_propertyList.insert("fo:clip", "auto");
+      state.m_graphic.edit().m_propertyList.insert("fo:clip", "auto");
     else {
       librevenge::RVNGString clip;
       clip.sprintf("rect(%fpt,%ftt,%fpt,%fpt)", state.convertInPoint(m_leftTop[1]), state.convertInPoint(m_rightBottom[0]),
                    state.convertInPoint(m_rightBottom[1]), state.convertInPoint(m_leftTop[0]));
-      state.m_graphic.m_propertyList.insert("fo:clip", clip);
+      state.m_graphic.edit().m_propertyList.insert("fo:clip", clip);
     }
   }
 }
@@ -903,14 +903,14 @@ void StarGAttributeNamedArrow::addTo(StarState &state, std::set<StarAttribute co
     char const *pathName=m_type==XATTR_LINESTART ? "draw:marker-start-path" : "draw:marker-end-path";
     char const *viewboxName=m_type==XATTR_LINESTART ? "draw:marker-start-viewbox" : "draw:marker-end-viewbox";
     if (m_polygon.empty()) {
-      if (state.m_graphic.m_propertyList[pathName]) state.m_graphic.m_propertyList.remove(pathName);
-      if (state.m_graphic.m_propertyList[viewboxName]) state.m_graphic.m_propertyList.remove(viewboxName);
+      if (state.m_graphic.get().m_propertyList[pathName]) state.m_graphic.edit().m_propertyList.remove(pathName);
+      if (state.m_graphic.get().m_propertyList[viewboxName]) state.m_graphic.edit().m_propertyList.remove(viewboxName);
     }
     else {
       librevenge::RVNGString path, viewbox;
       if (m_polygon.convert(path, viewbox, state.m_global->m_relativeUnit, STOFFVec2f(0,0))) {
-        state.m_graphic.m_propertyList.insert(pathName, path);
-        state.m_graphic.m_propertyList.insert(viewboxName, viewbox);
+        state.m_graphic.edit().m_propertyList.insert(pathName, path);
+        state.m_graphic.edit().m_propertyList.insert(viewboxName, viewbox);
       }
     }
   }
@@ -920,7 +920,7 @@ void StarGAttributeNamedBitmap::addTo(StarState &state, std::set<StarAttribute c
 {
   if (m_type==XATTR_FILLBITMAP) {
     if (!m_bitmap.isEmpty())
-      m_bitmap.addAsFillImageTo(state.m_graphic.m_propertyList);
+      m_bitmap.addAsFillImageTo(state.m_graphic.edit().m_propertyList);
     else {
       STOFF_DEBUG_MSG(("StarGAttributeNamedBitmap::addTo: can not find the bitmap\n"));
     }
@@ -930,23 +930,23 @@ void StarGAttributeNamedBitmap::addTo(StarState &state, std::set<StarAttribute c
 void StarGAttributeNamedColor::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==XATTR_LINECOLOR)
-    state.m_graphic.m_propertyList.insert("svg:stroke-color", m_color.str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("svg:stroke-color", m_color.str().c_str());
   else if (m_type==XATTR_FILLCOLOR)
-    state.m_graphic.m_propertyList.insert("draw:fill-color", m_color.str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("draw:fill-color", m_color.str().c_str());
   else if (m_type==SDRATTR_SHADOWCOLOR) {
-    state.m_graphic.m_propertyList.insert("draw:shadow-color", m_color.str().c_str());
-    state.m_font.m_shadowColor=m_color;
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow-color", m_color.str().c_str());
+    state.m_font.edit().m_shadowColor=m_color;
   }
 }
 
 void StarGAttributeNamedDash::addTo(StarState &state, std::set<StarAttribute const *> &/*done*/) const
 {
   if (m_type==XATTR_LINEDASH) {
-    state.m_graphic.m_propertyList.insert("draw:dots1", m_numbers[0]);
-    state.m_graphic.m_propertyList.insert("draw:dots1-length", state.convertInPoint(m_lengths[0]), librevenge::RVNG_POINT);
-    state.m_graphic.m_propertyList.insert("draw:dots2", m_numbers[1]);
-    state.m_graphic.m_propertyList.insert("draw:dots2-length", state.convertInPoint(m_lengths[1]), librevenge::RVNG_POINT);
-    state.m_graphic.m_propertyList.insert("draw:distance", state.convertInPoint(m_distance), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:dots1", m_numbers[0]);
+    state.m_graphic.edit().m_propertyList.insert("draw:dots1-length", state.convertInPoint(m_lengths[0]), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:dots2", m_numbers[1]);
+    state.m_graphic.edit().m_propertyList.insert("draw:dots2-length", state.convertInPoint(m_lengths[1]), librevenge::RVNG_POINT);
+    state.m_graphic.edit().m_propertyList.insert("draw:distance", state.convertInPoint(m_distance), librevenge::RVNG_POINT);
   }
 }
 
@@ -958,19 +958,19 @@ void StarGAttributeNamedGradient::addTo(StarState &state, std::set<StarAttribute
       return;
     if (m_gradientType>=0 && m_gradientType<=5) {
       char const *wh[]= {"linear", "axial", "radial", "ellipsoid", "square", "rectangle"};
-      state.m_graphic.m_propertyList.insert("draw:style", wh[m_gradientType]);
+      state.m_graphic.edit().m_propertyList.insert("draw:style", wh[m_gradientType]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGAttributeNamedGradient::addTo: unknown hash type %d\n", m_gradientType));
     }
-    state.m_graphic.m_propertyList.insert("draw:angle", double(m_angle)/10, librevenge::RVNG_GENERIC);
-    state.m_graphic.m_propertyList.insert("draw:border", double(m_border)/100, librevenge::RVNG_PERCENT);
-    state.m_graphic.m_propertyList.insert("draw:start-color", m_colors[0].str().c_str());
-    state.m_graphic.m_propertyList.insert("librevenge:start-opacity", double(m_intensities[0])/100, librevenge::RVNG_PERCENT);
-    state.m_graphic.m_propertyList.insert("draw:end-color", m_colors[1].str().c_str());
-    state.m_graphic.m_propertyList.insert("librevenge:end-opacity", double(m_intensities[1])/100, librevenge::RVNG_PERCENT);
-    state.m_graphic.m_propertyList.insert("svg:cx", double(m_offsets[0])/100, librevenge::RVNG_PERCENT);
-    state.m_graphic.m_propertyList.insert("svg:cy", double(m_offsets[1])/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:angle", double(m_angle)/10, librevenge::RVNG_GENERIC);
+    state.m_graphic.edit().m_propertyList.insert("draw:border", double(m_border)/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:start-color", m_colors[0].str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("librevenge:start-opacity", double(m_intensities[0])/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("draw:end-color", m_colors[1].str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("librevenge:end-opacity", double(m_intensities[1])/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("svg:cx", double(m_offsets[0])/100, librevenge::RVNG_PERCENT);
+    state.m_graphic.edit().m_propertyList.insert("svg:cy", double(m_offsets[1])/100, librevenge::RVNG_PERCENT);
     // m_step ?
   }
 }
@@ -980,14 +980,14 @@ void StarGAttributeNamedHatch::addTo(StarState &state, std::set<StarAttribute co
   if (m_type==XATTR_FILLHATCH && m_distance>0) {
     if (m_hatchType>=0 && m_hatchType<3) {
       char const *wh[]= {"single", "double", "triple"};
-      state.m_graphic.m_propertyList.insert("draw:style", wh[m_hatchType]);
+      state.m_graphic.edit().m_propertyList.insert("draw:style", wh[m_hatchType]);
     }
     else {
       STOFF_DEBUG_MSG(("StarGraphicAttribute::StarGAttributeNamedHatch::addTo: unknown hash type %d\n", m_hatchType));
     }
-    state.m_graphic.m_propertyList.insert("draw:color", m_color.str().c_str());
-    state.m_graphic.m_propertyList.insert("draw:distance", state.convertInPoint(m_distance),librevenge::RVNG_POINT);
-    if (m_angle) state.m_graphic.m_propertyList.insert("draw:rotation", double(m_angle)/10, librevenge::RVNG_GENERIC);
+    state.m_graphic.edit().m_propertyList.insert("draw:color", m_color.str().c_str());
+    state.m_graphic.edit().m_propertyList.insert("draw:distance", state.convertInPoint(m_distance),librevenge::RVNG_POINT);
+    if (m_angle) state.m_graphic.edit().m_propertyList.insert("draw:rotation", double(m_angle)/10, librevenge::RVNG_GENERIC);
   }
 }
 
@@ -1080,12 +1080,11 @@ bool StarGAttributeNamedArrow::read(StarZone &zone, int nVers, long endPos, Star
       nPoints=0;
     }
     f << "pts=[";
-    m_polygon.m_points.resize(size_t(nPoints));
+    m_polygon.resize(size_t(nPoints));
     for (size_t i=0; i<size_t(nPoints); ++i) {
       int dim[2];
       for (int &j : dim) j=int(input->readLong(4));
-      m_polygon.m_points[i].m_point=STOFFVec2i(dim[0],dim[1]);
-      m_polygon.m_points[i].m_flags=int(input->readULong(4));
+      m_polygon.setPoint(i, STOFFVec2i(dim[0],dim[1]), int(input->readULong(4)));
     }
     f << "],";
   }
@@ -31,8 +31,12 @@
 * instead of those above.
 */
 
+#include <algorithm>
 #include <math.h>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <tuple>
 
 #include <librevenge/librevenge.h>
 
@@ -175,70 +179,61 @@ static bool getBMPData(uint16_t const *pattern, STOFFColor const &col0,  STOFFCo
   return true;
 }
 
-////////////////////////////////////////////////////////////
-// utilities to compute bdbox
-////////////////////////////////////////////////////////////
-static double getInchValue(librevenge::RVNGProperty const *prop)
-{
-  double value=prop->getDouble();
-  switch (prop->getUnit()) {
-  case librevenge::RVNG_INCH:
-  case librevenge::RVNG_GENERIC: // assume inch
-    return value;
-  case librevenge::RVNG_POINT:
-    return value/72.;
-  case librevenge::RVNG_TWIP:
-    return value/1440.;
-  case librevenge::RVNG_PERCENT:
-  case librevenge::RVNG_UNIT_ERROR:
-  default: {
-    static bool first=true;
-    if (first) {
-      STOFF_DEBUG_MSG(("StarGraphicStruct::getInchValue: call with no double value\n"));
-      first=false;
-    }
-    break;
+/** Internal: a small cache of the bitmaps created from a 8*8 pattern
+
+    \note the same brushs are often used by thousand of cells/shapes,
+    so it is simpler to create each bitmap only one time. As
+    librevenge::RVNGBinaryData shares its content, returning a copy of
+    the stored object is cheap.
+ */
+struct PatternCache {
+  //! the key: the pattern bits, the two colors and the bitmap size
+  typedef std::tuple<uint64_t, uint32_t, uint32_t, int, int> Key;
+  //! constructor
+  PatternCache()
+    : m_mutex()
+    , m_keyToObjectMap()
+  {
   }
+  //! try to retrieve a pattern object, creates it if needed
+  bool get(uint16_t const *pattern, STOFFColor const &col0,  STOFFColor const &col1, STOFFEmbeddedObject &object)
+  {
+    if (!pattern) return false;
+    uint64_t bits=0;
+    for (int i=0; i<4; ++i) bits=(bits<<16)|pattern[i];
+    Key const key(bits, col0.value(), col1.value(), 8, 8);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it=m_keyToObjectMap.find(key);
+    if (it!=m_keyToObjectMap.end()) {
+      object=it->second;
+      return true;
+    }
+    librevenge::RVNGBinaryData data;
+    if (!getBMPData(pattern, col0, col1, data) || data.empty())
+      return false;
+    // the number of different brushs is normally small, but let us be careful
+    if (m_keyToObjectMap.size()>=256)
+      m_keyToObjectMap.clear();
+    object=STOFFEmbeddedObject(data, "image/bmp");
+    m_keyToObjectMap[key]=object;
+    return true;
   }
-  return value;
-}
-
-static double quadraticExtreme(double t, double a, double b, double c)
-{
-  return (1.0-t)*(1.0-t)*a + 2.0*(1.0-t)*t*b + t*t*c;
-}
-
-static double quadraticDerivative(double a, double b, double c)
-{
-  double denominator = a - 2.0*b + c;
-  if (fabs(denominator)>1e-10*(a-b))
-    return (a - b)/denominator;
-  return -1.0;
-}
-
-static void getQuadraticBezierBBox(double x0, double y0, double x1, double y1, double x, double y,
-                                   double &xmin, double &ymin, double &xmax, double &ymax)
+  //! the mutex
+  std::mutex m_mutex;
+  //! the map key to object
+  std::map<Key, STOFFEmbeddedObject> m_keyToObjectMap;
+};
+
+//! Internal: returns the pattern cache
+static PatternCache &getPatternCache()
 {
-  xmin = x0 < x ? x0 : x;
-  xmax = x0 > x ? x0 : x;
-  ymin = y0 < y ? y0 : y;
-  ymax = y0 > y ? y0 : y;
-
-  double t = quadraticDerivative(x0, x1, x);
-  if (t>=0 && t<=1) {
-    double tmpx = quadraticExtreme(t, x0, x1, x);
-    xmin = tmpx < xmin ? tmpx : xmin;
-    xmax = tmpx > xmax ? tmpx : xmax;
-  }
-
-  t = quadraticDerivative(y0, y1, y);
-  if (t>=0 && t<=1) {
-    double tmpy = quadraticExtreme(t, y0, y1, y);
-    ymin = tmpy < ymin ? tmpy : ymin;
-    ymax = tmpy > ymax ? tmpy : ymax;
-  }
+  static PatternCache s_cache;
+  return s_cache;
 }
 
+////////////////////////////////////////////////////////////
+// utilities to compute bdbox
+////////////////////////////////////////////////////////////
 static double cubicBase(double t, double a, double b, double c, double d)
 {
   return (1.0-t)*(1.0-t)*(1.0-t)*a + 3.0*(1.0-t)*(1.0-t)*t*b + 3.0*(1.0-t)*t*t*c + t*t*t*d;
@@ -263,158 +258,20 @@ static void getCubicBezierBBox(double x0, double y0, double x1, double y1, doubl
   }
 }
 
-//! Internal: helper to compute a path bdbox
-static bool getPathBBox(const librevenge::RVNGPropertyListVector &path, double &px, double &py, double &qx, double &qy)
+//! Internal: helper to append an integer to a svg:d string, ie. sprintf("%i") without any locale
+static void appendPathValue(std::string &path, int value)
 {
-  // This must be a mistake and we do not want to crash lower
-  if (!path.count() || !path[0]["librevenge:path-action"] || path[0]["librevenge:path-action"]->getStr() == "Z") {
-    STOFF_DEBUG_MSG(("libodfgen:getPathBdBox: get a spurious path\n"));
-    return false;
+  char buffer[16];
+  char *end=buffer+sizeof(buffer), *ptr=end;
+  auto val=value<0 ? -static_cast<unsigned long>(value) : static_cast<unsigned long>(value);
+  do {
+    *(--ptr)=char('0'+val%10);
+    val/=10;
   }
-
-  // try to find the bounding box
-  // this is simple convex hull technique, the bounding box might not be
-  // accurate but that should be enough for this purpose
-  bool isFirstPoint = true;
-
-  double lastX = 0.0;
-  double lastY = 0.0;
-  double lastPrevX = 0.0;
-  double lastPrevY = 0.0;
-  px = py = qx = qy = 0.0;
-
-  for (unsigned long k = 0; k < path.count(); ++k) {
-    if (!path[k]["librevenge:path-action"])
-      continue;
-    std::string action=path[k]["librevenge:path-action"]->getStr().cstr();
-    if (action.length()!=1 || action[0]=='Z') continue;
-
-    bool coordOk=path[k]["svg:x"]&&path[k]["svg:y"];
-    bool coord1Ok=coordOk && path[k]["svg:x1"]&&path[k]["svg:y1"];
-    bool coord2Ok=coord1Ok && path[k]["svg:x2"]&&path[k]["svg:y2"];
-    double x=lastX, y=lastY;
-    if (isFirstPoint) {
-      if (!coordOk) {
-        STOFF_DEBUG_MSG(("StarGraphicStruct::getPathBBox: the first point has no coordinate\n"));
-        continue;
-      }
-      qx = px = x = getInchValue(path[k]["svg:x"]);
-      qy = py = y = getInchValue(path[k]["svg:y"]);
-      lastPrevX = lastX = px;
-      lastPrevY = lastY = py;
-      isFirstPoint = false;
-    }
-    else {
-      if (path[k]["svg:x"]) x=getInchValue(path[k]["svg:x"]);
-      if (path[k]["svg:y"]) y=getInchValue(path[k]["svg:y"]);
-      px = (px > x) ? x : px;
-      py = (py > y) ? y : py;
-      qx = (qx < x) ? x : qx;
-      qy = (qy < y) ? y : qy;
-    }
-
-    double xmin=px, xmax=qx, ymin=py, ymax=qy;
-    bool lastPrevSet=false;
-
-    if (action[0] == 'C' && coord2Ok) {
-      getCubicBezierBBox(lastX, lastY, getInchValue(path[k]["svg:x1"]), getInchValue(path[k]["svg:y1"]),
-                         getInchValue(path[k]["svg:x2"]), getInchValue(path[k]["svg:y2"]),
-                         x, y, xmin, ymin, xmax, ymax);
-      lastPrevSet=true;
-      lastPrevX=2*x-getInchValue(path[k]["svg:x2"]);
-      lastPrevY=2*y-getInchValue(path[k]["svg:y2"]);
-    }
-    else if (action[0] == 'S' && coord1Ok) {
-      getCubicBezierBBox(lastX, lastY, lastPrevX, lastPrevY,
-                         getInchValue(path[k]["svg:x1"]), getInchValue(path[k]["svg:y1"]),
-                         x, y, xmin, ymin, xmax, ymax);
-      lastPrevSet=true;
-      lastPrevX=2*x-getInchValue(path[k]["svg:x1"]);
-      lastPrevY=2*y-getInchValue(path[k]["svg:y1"]);
-    }
-    else if (action[0] == 'Q' && coord1Ok) {
-      getQuadraticBezierBBox(lastX, lastY, getInchValue(path[k]["svg:x1"]), getInchValue(path[k]["svg:y1"]),
-                             x, y, xmin, ymin, xmax, ymax);
-      lastPrevSet=true;
-      lastPrevX=2*x-getInchValue(path[k]["svg:x1"]);
-      lastPrevY=2*y-getInchValue(path[k]["svg:y1"]);
-    }
-    else if (action[0] == 'T' && coordOk) {
-      getQuadraticBezierBBox(lastX, lastY, lastPrevX, lastPrevY,
-                             x, y, xmin, ymin, xmax, ymax);
-      lastPrevSet=true;
-      lastPrevX=2*x-lastPrevX;
-      lastPrevY=2*y-lastPrevY;
-    }
-    else if (action[0] != 'M' && action[0] != 'L' && action[0] != 'H' && action[0] != 'V') {
-      STOFF_DEBUG_MSG(("StarGraphicStruct::getPathBBox: problem reading a path\n"));
-    }
-    px = (px > xmin ? xmin : px);
-    py = (py > ymin ? ymin : py);
-    qx = (qx < xmax ? xmax : qx);
-    qy = (qy < ymax ? ymax : qy);
-    lastX = x;
-    lastY = y;
-    if (!lastPrevSet) {
-      lastPrevX=lastX;
-      lastPrevY=lastY;
-    }
-  }
-  return true;
-}
-
-//! Internal: helper to convert a path in a string
-static librevenge::RVNGString convertPath(const librevenge::RVNGPropertyListVector &path)
-{
-  librevenge::RVNGString sValue("");
-  for (unsigned long i = 0; i < path.count(); ++i) {
-    if (!path[i]["librevenge:path-action"])
-      continue;
-    std::string action=path[i]["librevenge:path-action"]->getStr().cstr();
-    if (action.length()!=1) continue;
-    bool coordOk=path[i]["svg:x"]&&path[i]["svg:y"];
-    bool coord1Ok=coordOk && path[i]["svg:x1"]&&path[i]["svg:y1"];
-    bool coord2Ok=coord1Ok && path[i]["svg:x2"]&&path[i]["svg:y2"];
-    librevenge::RVNGString sElement;
-    // 2540 is 2.54*1000, 2.54 in = 1 inch
-    if (path[i]["svg:x"] && action[0] == 'H') {
-      sElement.sprintf("H%i", int(getInchValue(path[i]["svg:x"])*2540));
-      sValue.append(sElement);
-    }
-    else if (path[i]["svg:y"] && action[0] == 'V') {
-      sElement.sprintf("V%i", int(getInchValue(path[i]["svg:y"])*2540));
-      sValue.append(sElement);
-    }
-    else if (coordOk && (action[0] == 'M' || action[0] == 'L' || action[0] == 'T')) {
-      sElement.sprintf("%c%i %i", action[0], int(getInchValue(path[i]["svg:x"])*2540),
-                       int(getInchValue(path[i]["svg:y"])*2540));
-      sValue.append(sElement);
-    }
-    else if (coord1Ok && (action[0] == 'Q' || action[0] == 'S')) {
-      sElement.sprintf("%c%i %i %i %i", action[0], int(getInchValue(path[i]["svg:x1"])*2540),
-                       int(getInchValue(path[i]["svg:y1"])*2540), int(getInchValue(path[i]["svg:x"])*2540),
-                       int(getInchValue(path[i]["svg:y"])*2540));
-      sValue.append(sElement);
-    }
-    else if (coord2Ok && action[0] == 'C') {
-      sElement.sprintf("C%i %i %i %i %i %i", int(getInchValue(path[i]["svg:x1"])*2540),
-                       int(getInchValue(path[i]["svg:y1"])*2540), int(getInchValue(path[i]["svg:x2"])*2540),
-                       int(getInchValue(path[i]["svg:y2"])*2540), int(getInchValue(path[i]["svg:x"])*2540),
-                       int(getInchValue(path[i]["svg:y"])*2540));
-      sValue.append(sElement);
-    }
-    else if (coordOk && path[i]["svg:rx"] && path[i]["svg:ry"] && action[0] == 'A') {
-      sElement.sprintf("A%i %i %i %i %i %i %i", int((getInchValue(path[i]["svg:rx"]))*2540),
-                       int((getInchValue(path[i]["svg:ry"]))*2540), (path[i]["librevenge:rotate"] ? path[i]["librevenge:rotate"]->getInt() : 0),
-                       (path[i]["librevenge:large-arc"] ? path[i]["librevenge:large-arc"]->getInt() : 1),
-                       (path[i]["librevenge:sweep"] ? path[i]["librevenge:sweep"]->getInt() : 1),
-                       int(getInchValue(path[i]["svg:x"])*2540), int(getInchValue(path[i]["svg:y"])*2540));
-      sValue.append(sElement);
-    }
-    else if (action[0] == 'Z')
-      sValue.append(" Z");
-  }
-  return sValue;
+  while (val);
+  if (value<0)
+    *(--ptr)='-';
+  path.append(ptr, size_t(end-ptr));
 }
 
 bool StarBrush::getColor(STOFFColor &color) const
@@ -448,11 +305,9 @@ bool StarBrush::getPattern(STOFFEmbeddedObject &object, STOFFVec2i &sz) const
     0xaa55, 0xaa55, 0xaa55, 0xaa55, // brush50
     0x77dd, 0x77dd, 0x77dd, 0x77dd, // brush75
   };
-  librevenge::RVNGBinaryData data;
-  if (!getBMPData(&(s_pattern[4*(m_style-1)]), m_fillColor, m_color, data) || data.empty())
+  if (!getPatternCache().get(&(s_pattern[4*(m_style-1)]), m_fillColor, m_color, object))
     return false;
   sz=STOFFVec2i(8,8);
-  object.add(data, "image/bmp");
   return true;
 }
 }
@@ -678,31 +533,33 @@ bool StarGraphicStruct::StarGraphic::read(StarZone &zone, long endPos)
 void StarPolygon::addToPath(librevenge::RVNGPropertyListVector &path, bool isClosed, double relUnit, STOFFVec2f const &decal) const
 {
   librevenge::RVNGPropertyList element;
-  for (size_t i=0; i<m_points.size(); ++i) {
-    if (m_points[i].m_flags==2 && i+2<m_points.size() && m_points[i].m_flags==2) {
-      element.insert("svg:x1",relUnit*(m_points[i].m_point[0]-double(decal[0])), librevenge::RVNG_POINT);
-      element.insert("svg:y1",relUnit*(m_points[i].m_point[1]-double(decal[1])), librevenge::RVNG_POINT);
-      element.insert("svg:x2",relUnit*(m_points[++i].m_point[0]-double(decal[0])), librevenge::RVNG_POINT);
-      element.insert("svg:y2",relUnit*(m_points[i].m_point[1]-double(decal[1])), librevenge::RVNG_POINT);
-      element.insert("svg:x",relUnit*(m_points[++i].m_point[0]-double(decal[0])), librevenge::RVNG_POINT);
-      element.insert("svg:y",relUnit*(m_points[i].m_point[1]-double(decal[1])), librevenge::RVNG_POINT);
+  auto const numPoints=m_points.size();
+  double const dx=double(decal[0]), dy=double(decal[1]);
+  for (size_t i=0; i<numPoints; ++i) {
+    if (m_flags[i]==2 && i+2<numPoints) {
+      element.insert("svg:x1",relUnit*(m_points[i][0]-dx), librevenge::RVNG_POINT);
+      element.insert("svg:y1",relUnit*(m_points[i][1]-dy), librevenge::RVNG_POINT);
+      element.insert("svg:x2",relUnit*(m_points[++i][0]-dx), librevenge::RVNG_POINT);
+      element.insert("svg:y2",relUnit*(m_points[i][1]-dy), librevenge::RVNG_POINT);
+      element.insert("svg:x",relUnit*(m_points[++i][0]-dx), librevenge::RVNG_POINT);
+      element.insert("svg:y",relUnit*(m_points[i][1]-dy), librevenge::RVNG_POINT);
       element.insert("librevenge:path-action", "C");
     }
-    else if (m_points[i].m_flags==2 && i+1<m_points.size()) {
+    else if (m_flags[i]==2 && i+1<numPoints) {
       /* unsure, let asume that this means the previous point is symetric,
          but maybe we can also have a Bezier patch */
-      element.insert("svg:x1",relUnit*(m_points[i].m_point[0]-double(decal[0])), librevenge::RVNG_POINT);
-      element.insert("svg:y1",relUnit*(m_points[i].m_point[1]-double(decal[1])), librevenge::RVNG_POINT);
-      element.insert("svg:x",relUnit*(m_points[++i].m_point[0]-double(decal[0])), librevenge::RVNG_POINT);
-      element.insert("svg:y",relUnit*(m_points[i].m_point[1]-double(decal[1])), librevenge::RVNG_POINT);
+      element.insert("svg:x1",relUnit*(m_points[i][0]-dx), librevenge::RVNG_POINT);
+      element.insert("svg:y1",relUnit*(m_points[i][1]-dy), librevenge::RVNG_POINT);
+      element.insert("svg:x",relUnit*(m_points[++i][0]-dx), librevenge::RVNG_POINT);
+      element.insert("svg:y",relUnit*(m_points[i][1]-dy), librevenge::RVNG_POINT);
       element.insert("librevenge:path-action", "S");
     }
     else {
-      if (m_points[i].m_flags==2) {
+      if (m_flags[i]==2) {
         STOFF_DEBUG_MSG(("StarGraphicStruct::StarPolygon::addToPath: find unexpected flags\n"));
       }
-      element.insert("svg:x",relUnit*(m_points[i].m_point[0]-double(decal[0])), librevenge::RVNG_POINT);
-      element.insert("svg:y",relUnit*(m_points[i].m_point[1]-double(decal[1])), librevenge::RVNG_POINT);
+      element.insert("svg:x",relUnit*(m_points[i][0]-dx), librevenge::RVNG_POINT);
+      element.insert("svg:y",relUnit*(m_points[i][1]-dy), librevenge::RVNG_POINT);
       element.insert("librevenge:path-action", (i==0 ? "M" : "L"));
     }
     path.append(element);
@@ -715,12 +572,79 @@ void StarPolygon::addToPath(librevenge::RVNGPropertyListVector &path, bool isClo
 
 bool StarPolygon::convert(librevenge::RVNGString &path, librevenge::RVNGString &viewbox, double relUnit, STOFFVec2f const &decal) const
 {
-  librevenge::RVNGPropertyListVector pathVect;
-  addToPath(pathVect, true, relUnit, decal);
-  path=convertPath(pathVect);
-  double bounds[4];
-  if (path.empty() || !getPathBBox(pathVect, bounds[0], bounds[1], bounds[2], bounds[3]))
+  /* same path as addToPath(...,true,...) but the svg:d string is
+     created directly: the coordinates are stored in inch*2540 and the
+     bdbox is computed in inch */
+  path.clear();
+  auto const numPoints=m_points.size();
+  if (!numPoints)
     return false;
+  std::string d;
+  d.reserve(16*numPoints+2);
+  double bounds[4]= {0,0,0,0}; // xmin, ymin, xmax, ymax
+  double last[2]= {0,0}, lastPrev[2]= {0,0};
+  bool first=true;
+  for (size_t i=0; i<numPoints; ++i) {
+    char action;
+    // the coordinates of x1,y1,x2,y2,x,y in inch
+    double coord[6]= {0,0,0,0,0,0};
+    int firstCoord;
+    if (m_flags[i]==2 && i+2<numPoints) {
+      action='C';
+      firstCoord=0;
+    }
+    else if (m_flags[i]==2 && i+1<numPoints) {
+      action='S';
+      firstCoord=2;
+    }
+    else {
+      action=i==0 ? 'M' : 'L';
+      firstCoord=4;
+    }
+    for (int c=firstCoord; c<6; c+=2, ++i) {
+      coord[c]=relUnit*(m_points[i][0]-double(decal[0]))/72.;
+      coord[c+1]=relUnit*(m_points[i][1]-double(decal[1]))/72.;
+    }
+    --i;
+    d+=action;
+    for (int c=firstCoord; c<6; ++c) {
+      if (c!=firstCoord) d+=' ';
+      appendPathValue(d, int(coord[c]*2540));
+    }
+
+    // update the bdbox
+    double const x=coord[4], y=coord[5];
+    if (first) {
+      first=false;
+      bounds[0]=bounds[2]=last[0]=lastPrev[0]=x;
+      bounds[1]=bounds[3]=last[1]=lastPrev[1]=y;
+    }
+    else {
+      bounds[0]=std::min(bounds[0], x);
+      bounds[1]=std::min(bounds[1], y);
+      bounds[2]=std::max(bounds[2], x);
+      bounds[3]=std::max(bounds[3], y);
+    }
+    if (action=='C' || action=='S') {
+      double const *ctrl1=action=='C' ? coord : lastPrev;
+      double box[4];
+      getCubicBezierBBox(last[0], last[1], ctrl1[0], ctrl1[1], coord[2], coord[3], x, y, box[0], box[1], box[2], box[3]);
+      bounds[0]=std::min(bounds[0], box[0]);
+      bounds[1]=std::min(bounds[1], box[1]);
+      bounds[2]=std::max(bounds[2], box[2]);
+      bounds[3]=std::max(bounds[3], box[3]);
+      lastPrev[0]=2*x-coord[2];
+      lastPrev[1]=2*y-coord[3];
+    }
+    else {
+      lastPrev[0]=x;
+      lastPrev[1]=y;
+    }
+    last[0]=x;
+    last[1]=y;
+  }
+  d+=" Z";
+  path=d.c_str();
   std::stringstream s;
   s << long(bounds[0]*1440) << " " << long(bounds[1]*1440) << " " << long(bounds[2]*1440) << " " << long(bounds[3]*1440);
   viewbox=s.str().c_str();
@@ -731,8 +655,26 @@ bool StarPolygon::convert(librevenge::RVNGString &path, librevenge::RVNGString &
 std::ostream &operator<<(std::ostream &o, StarPolygon const &poly)
 {
   o << "points=[";
-  for (auto const &pt : poly.m_points)
-    o << pt << ",";
+  for (size_t i=0; i<poly.m_points.size(); ++i) {
+    o << poly.m_points[i];
+    switch (poly.m_flags[i]) {
+    case 0:
+      break;
+    case 1: // smooth
+      o << ":s";
+      break;
+    case 2: // control
+      o << ":c";
+      break;
+    case 3: // symetric
+      o << ":S";
+      break;
+    default:
+      STOFF_DEBUG_MSG(("StarGraphicStruct::StarPolygon::operator<< unexpected flag\n"));
+      o << ":[##" << int(poly.m_flags[i]) << "]";
+    }
+    o << ",";
+  }
   o << "],";
   return o;
 }
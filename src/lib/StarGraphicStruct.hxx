@@ -122,51 +122,17 @@ public:
 class StarPolygon
 {
 public:
-  //! a structure to keep a point and a flag
-  struct Point {
-    //! constructor
-    explicit Point(STOFFVec2i point=STOFFVec2i(), int flag=0)
-      : m_point(point)
-      , m_flags(flag)
-    {
-    }
-    //! operator<<
-    friend std::ostream &operator<<(std::ostream &o, Point const &point)
-    {
-      o << point.m_point;
-      switch (point.m_flags) {
-      case 0:
-        break;
-      case 1: // smooth
-        o << ":s";
-        break;
-      case 2: // control
-        o << ":c";
-        break;
-      case 3: // symetric
-        o << ":S";
-        break;
-      default:
-        STOFF_DEBUG_MSG(("StarObjectSmallGraphicStruct::StarPolygon::Point::operator<< unexpected flag\n"));
-        o << ":[##" << point.m_flags << "]";
-      }
-      return o;
-    }
-    //! the point
-    STOFFVec2i m_point;
-    //! the flags
-    int m_flags;
-  };
   //! contructor
   StarPolygon()
     : m_points()
+    , m_flags()
   {
   }
   //! check if a polygon has special point
   bool hasSpecialPoints() const
   {
-    for (auto const &pt : m_points) {
-      if (pt.m_flags)
+    for (auto flag : m_flags) {
+      if (flag)
         return true;
     }
     return false;
@@ -181,14 +147,71 @@ public:
   {
     return m_points.size();
   }
+  //! reserves memory for n points
+  void reserve(size_t n)
+  {
+    m_points.reserve(n);
+    m_flags.reserve(n);
+  }
+  //! resizes the polygon, the new points are set to (0,0)
+  void resize(size_t n)
+  {
+    m_points.resize(n);
+    m_flags.resize(n, 0);
+  }
+  //! adds a point with its flag: 0 normal, 1 smooth, 2 control, 3 symetric
+  void addPoint(STOFFVec2i const &point, int flag=0)
+  {
+    m_points.push_back(point);
+    m_flags.push_back(getFlagValue(flag));
+  }
+  //! sets the i^th point and its flag
+  void setPoint(size_t i, STOFFVec2i const &point, int flag=0)
+  {
+    if (i>=m_points.size()) {
+      STOFF_DEBUG_MSG(("StarGraphicStruct::StarPolygon::setPoint: the index %d is bad\n", int(i)));
+      return;
+    }
+    m_points[i]=point;
+    m_flags[i]=getFlagValue(flag);
+  }
+  //! sets the i^th point flag
+  void setFlag(size_t i, int flag)
+  {
+    if (i>=m_flags.size()) {
+      STOFF_DEBUG_MSG(("StarGraphicStruct::StarPolygon::setFlag: the index %d is bad\n", int(i)));
+      return;
+    }
+    m_flags[i]=getFlagValue(flag);
+  }
+  //! returns the i^th point
+  STOFFVec2i const &getPoint(size_t i) const
+  {
+    return m_points[i];
+  }
+  //! returns the i^th point flag
+  int getFlag(size_t i) const
+  {
+    return int(m_flags[i]);
+  }
   //! add the polygon to a path
   void addToPath(librevenge::RVNGPropertyListVector &path, bool isClosed, double relUnit, STOFFVec2f const &decal) const;
-  //! convert a path in a string and update the bdbox
+  /** convert a closed path in a svg:d string and update the bdbox
+
+   \note the string is created directly from the points, ie. without creating a property list by point */
   bool convert(librevenge::RVNGString &path, librevenge::RVNGString &viewbox, double relUnit, STOFFVec2f const &decal) const;
   //! operator<<
   friend std::ostream &operator<<(std::ostream &o, StarPolygon const &poly);
+protected:
+  //! returns the value used to store a flag
+  static uint8_t getFlagValue(int flag)
+  {
+    return (flag<0 || flag>0xFF) ? uint8_t(0xFF) : uint8_t(flag);
+  }
   //! the list of points
-  std::vector<Point> m_points;
+  std::vector<STOFFVec2i> m_points;
+  //! the list of flags (one by point)
+  std::vector<uint8_t> m_flags;
 };
 
 }
@@ -166,7 +166,7 @@ struct SfxMultiRecord {
     return true;
   }
   //! try to close a zone
-  void close(std::string const &wh)
+  void close(char const *wh)
   {
     if (!m_zone) return;
     if (!m_zoneOpened) {
@@ -185,7 +185,7 @@ struct SfxMultiRecord {
     m_zone=nullptr;
   }
   //! try to go to the new content positon
-  bool getNewContent(std::string const &wh, int &id)
+  bool getNewContent(char const *wh, int &id)
   {
     if (!m_zone) return false;
     // SfxMultiRecordReader::GetContent
@@ -2180,15 +2180,15 @@ void StarItemPool::defineGraphicStyle(STOFFListenerPtr listener, librevenge::RVN
     return;
   }
   StarState state(this, object);
-  state.m_frame.addTo(state.m_graphic.m_propertyList);
-  state.m_graphic.m_propertyList.insert("style:display-name", styleName);
+  state.m_frame->addTo(state.m_graphic.edit().m_propertyList);
+  state.m_graphic.edit().m_propertyList.insert("style:display-name", styleName);
   if (!style->m_names[1].empty()) {
     if (done.find(style->m_names[1])!=done.end()) {
       STOFF_DEBUG_MSG(("StarItemPool::defineGraphicStyle: oops find a look with %s", style->m_names[1].cstr()));
     }
     else {
       defineGraphicStyle(listener, style->m_names[1], object, done);
-      state.m_graphic.m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
     }
   }
   for (auto it : style->m_itemSet.m_whichToItemMap) {
@@ -2216,17 +2216,17 @@ void StarItemPool::defineParagraphStyle(STOFFListenerPtr listener, librevenge::R
   }
   StarState state(this, object);
   if (style->m_outlineLevel>=0 && style->m_outlineLevel<20) {
-    state.m_paragraph.m_outline=true;
-    state.m_paragraph.m_listLevelIndex=style->m_outlineLevel+1;
+    state.m_paragraph.edit().m_outline=true;
+    state.m_paragraph.edit().m_listLevelIndex=style->m_outlineLevel+1;
   }
-  state.m_paragraph.m_propertyList.insert("style:display-name", styleName);
+  state.m_paragraph.edit().m_propertyList.insert("style:display-name", styleName);
   if (!style->m_names[1].empty()) {
     if (done.find(style->m_names[1])!=done.end()) {
       STOFF_DEBUG_MSG(("StarItemPool::defineParagraphStyle: oops find a look with %s", style->m_names[1].cstr()));
     }
     else {
       defineParagraphStyle(listener, style->m_names[1], object, done);
-      state.m_paragraph.m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
+      state.m_paragraph.edit().m_propertyList.insert("librevenge:parent-display-name", style->m_names[1]);
     }
   }
   for (auto it : style->m_itemSet.m_whichToItemMap) {
@@ -50,6 +50,30 @@
 /** Internal: the structures of a StarObject */
 namespace StarObjectInternal
 {
+//! the document context of a StarObject, shared by the object and its copies
+struct Context {
+  //! constructor
+  Context(char const *passwd, std::shared_ptr<STOFFOLEParser> const &oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> const &directory)
+    : m_password(passwd)
+    , m_oleParser(oleParser)
+    , m_directory(directory)
+    , m_metaData()
+  {
+  }
+  //! copy constructor
+  Context(Context const &) = default;
+  //! the document password
+  char const *m_password;
+  //! the ole parser
+  std::shared_ptr<STOFFOLEParser> m_oleParser;
+  //! the directory
+  std::shared_ptr<STOFFOLEParser::OleDirectory> m_directory;
+  //! the meta data
+  librevenge::RVNGPropertyList m_metaData;
+private:
+  Context &operator=(Context const &) = delete;
+};
+
 //! the state of a StarObject
 struct State {
   //! constructor
@@ -78,43 +102,70 @@ private:
 // constructor/destructor, ...
 ////////////////////////////////////////////////////////////
 StarObject::StarObject(char const *passwd, std::shared_ptr<STOFFOLEParser> &oleParser, std::shared_ptr<STOFFOLEParser::OleDirectory> &directory)
-  : m_password(passwd)
-  , m_oleParser(oleParser)
-  , m_directory(directory)
+  : m_context(new StarObjectInternal::Context(passwd, oleParser, directory))
   , m_state(new StarObjectInternal::State())
-  , m_metaData()
 {
 }
 
 StarObject::StarObject(StarObject const &orig, bool duplicateState)
-  : m_password(orig.m_password)
-  , m_oleParser(orig.m_oleParser)
-  , m_directory(orig.m_directory)
-  , m_state()
-  , m_metaData(orig.m_metaData)
+  : m_context(orig.m_context)
+  , m_state(duplicateState ? orig.m_state : std::make_shared<StarObjectInternal::State>())
 {
-  if (duplicateState)
-    m_state.reset(new StarObjectInternal::State(*orig.m_state));
-  else
-    m_state.reset(new StarObjectInternal::State);
 }
 
 StarObject::~StarObject()
 {
 }
 
+StarObjectInternal::Context &StarObject::getMutableContext()
+{
+  // the context and the state are only modified when reading the main zones,
+  // ie. before the objects are decoded concurrently
+  if (m_context.use_count()>1)
+    m_context.reset(new StarObjectInternal::Context(*m_context));
+  return *m_context;
+}
+
+StarObjectInternal::State &StarObject::getMutableState()
+{
+  if (m_state.use_count()>1)
+    m_state.reset(new StarObjectInternal::State(*m_state));
+  return *m_state;
+}
+
 void StarObject::cleanPools()
 {
   for (auto &p : m_state->m_poolList) {
     if (p)
       p->clean();
   }
-  m_state->m_poolList.clear();
+  getMutableState().m_poolList.clear();
+}
+
+char const *StarObject::getPassword() const
+{
+  return m_context->m_password;
+}
+
+std::shared_ptr<STOFFOLEParser> StarObject::getOLEParser() const
+{
+  return m_context->m_oleParser;
+}
+
+std::shared_ptr<STOFFOLEParser::OleDirectory> StarObject::getOLEDirectory()
+{
+  return m_context->m_directory;
+}
+
+librevenge::RVNGPropertyList const &StarObject::getMetaData() const
+{
+  return m_context->m_metaData;
 }
 
 STOFFDocument::Kind StarObject::getDocumentKind() const
 {
-  return m_directory ? m_directory->m_kind : STOFFDocument::STOFF_K_UNKNOWN;
+  auto const &directory=m_context->m_directory;
+  return directory ? directory->m_kind : STOFFDocument::STOFF_K_UNKNOWN;
 }
 
 std::shared_ptr<StarAttributeManager> StarObject::getAttributeManager()
@@ -142,7 +193,7 @@ librevenge::RVNGString StarObject::getUserNameMetaData(int i) const
 std::shared_ptr<StarItemPool> StarObject::getNewItemPool(StarItemPool::Type type)
 {
   std::shared_ptr<StarItemPool> pool(new StarItemPool(*this, type));
-  m_state->m_poolList.push_back(pool);
+  getMutableState().m_poolList.push_back(pool);
   return pool;
 }
 
@@ -167,22 +218,60 @@ std::shared_ptr<StarItemPool> StarObject::findItemPool(StarItemPool::Type type,
   return std::shared_ptr<StarItemPool>();
 }
 
+STOFFInputStreamPtr StarObject::openZone(std::string const &baseName, std::string &oleName)
+{
+  auto directory=m_context->m_directory;
+  if (!directory || !directory->m_input) {
+    STOFF_DEBUG_MSG(("StarObject::openZone: can not find directory\n"));
+    return STOFFInputStreamPtr();
+  }
+  for (auto &content : directory->m_contentList) {
+    if (content.isParsed() || content.getBaseName()!=baseName) continue;
+    oleName = content.getOleName();
+    auto ole = directory->m_input->getSubStreamByName(oleName.c_str());
+    if (!ole) {
+      STOFF_DEBUG_MSG(("StarObject::openZone: error: can not find OLE part: \"%s\"\n", oleName.c_str()));
+      return ole;
+    }
+    ole->setReadInverted(true);
+    content.setParsed(true);
+    return ole;
+  }
+  STOFF_DEBUG_MSG(("StarObject::openZone: can not find the zone %s\n", baseName.c_str()));
+  return STOFFInputStreamPtr();
+}
+
+bool StarObject::readDocumentInformation()
+{
+  std::string name;
+  auto ole=openZone("SfxDocumentInfo", name);
+  return ole && readSfxDocumentInformation(ole, name);
+}
+
+bool StarObject::readDocumentPreview(librevenge::RVNGBinaryData &data, std::string &type)
+{
+  std::string name;
+  auto ole=openZone("SfxPreview", name);
+  return ole && readSfxPreview(ole, name, data, type) && !data.empty();
+}
+
 bool StarObject::parse()
 {
-  if (!m_directory) {
+  auto directory=m_context->m_directory;
+  if (!directory) {
     STOFF_DEBUG_MSG(("StarObject::parse: can not find directory\n"));
     return false;
   }
-  if (!m_directory->m_hasCompObj) {
+  if (!directory->m_hasCompObj) {
     STOFF_DEBUG_MSG(("StarObject::parse: called with unknown document\n"));
   }
-  for (auto &content : m_directory->m_contentList) {
+  for (auto &content : directory->m_contentList) {
     if (content.isParsed()) continue;
     auto name = content.getOleName();
     auto const &base = content.getBaseName();
     STOFFInputStreamPtr ole;
-    if (m_directory->m_input)
-      ole = m_directory->m_input->getSubStreamByName(name.c_str());
+    if (directory->m_input)
+      ole = directory->m_input->getSubStreamByName(name.c_str());
     if (!ole.get()) {
       STOFF_DEBUG_MSG(("StarObject::createZones: error: can not find OLE part: \"%s\"\n", name.c_str()));
       continue;
@@ -191,7 +280,7 @@ bool StarObject::parse()
     ole->setReadInverted(true);
     if (base=="VCPool") {
       content.setParsed(true);
-      StarZone zone(ole, name, "VCPool", m_password);
+      StarZone zone(ole, name, "VCPool", getPassword());
       zone.ascii().open(name);
       ole->seek(0, librevenge::RVNG_SEEK_SET);
       getNewItemPool(StarItemPool::T_VCControlPool)->read(zone);
@@ -204,7 +293,12 @@ bool StarObject::parse()
     }
     if (base=="SfxPreview") {
       content.setParsed(true);
-      readSfxPreview(ole, name);
+      // the preview is not sent, see readDocumentPreview
+#if defined(DEBUG_WITH_FILES)
+      librevenge::RVNGBinaryData data;
+      std::string type;
+      readSfxPreview(ole, name, data, type);
+#endif
       continue;
     }
     if (base=="SfxDocumentInfo") {
@@ -286,7 +380,7 @@ bool StarObject::readItemSet(StarZone &zone, std::vector<STOFFVec2i> const &/*li
 
 bool StarObject::readPersistElements(STOFFInputStreamPtr input, std::string const &name)
 {
-  StarZone zone(input, name, "PersistsElement", m_password);
+  StarZone zone(input, name, "PersistsElement", getPassword());
   libstoff::DebugFile &ascii=zone.ascii();
   ascii.open(name);
   input->seek(0, librevenge::RVNG_SEEK_SET);
@@ -565,18 +659,18 @@ bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::stri
         "librevenge:template-name", "librevenge:template-filename"
       };
       if ((i%2)==1 && i>=7 && i<=13)
-        m_state->m_userMetaNames[(i-7)/2]=attrib;
+        getMutableState().m_userMetaNames[(i-7)/2]=attrib;
       if (attrib.empty() || std::string(attribNames[i]).empty())
         prevAttrib=attrib;
       else if (std::string(attribNames[i])=="user") {
         if (!prevAttrib.empty()) {
           librevenge::RVNGString userMeta("librevenge:");
           userMeta.append(prevAttrib);
-          m_metaData.insert(userMeta.cstr(), attrib);
+          getMutableContext().m_metaData.insert(userMeta.cstr(), attrib);
         }
       }
       else
-        m_metaData.insert(attribNames[i], attrib);
+        getMutableContext().m_metaData.insert(attribNames[i], attrib);
     }
     else {
       STOFF_DEBUG_MSG(("StarObject::readSfxDocumentInformation: can not convert a string\n"));
@@ -591,7 +685,7 @@ bool StarObject::readSfxDocumentInformation(STOFFInputStreamPtr input, std::stri
       std::string dateTime;
       if (date && libstoff::convertToDateTime(date,time, dateTime)) {
         static char const* const attribNames[]= { "meta:creation-date", "dc:date", "meta:print-date" };
-        m_metaData.insert(attribNames[i], dateTime.c_str());
+        getMutableContext().m_metaData.insert(attribNames[i], dateTime.c_str());
       }
     }
     ascii.addPos(pos);
@@ -797,14 +891,13 @@ bool StarObject::readStarFrameworkConfigItem(STOFFEntry &entry, STOFFInputStream
   return true;
 }
 
-bool StarObject::readSfxPreview(STOFFInputStreamPtr input, std::string const &name)
+bool StarObject::readSfxPreview(STOFFInputStreamPtr input, std::string const &name, librevenge::RVNGBinaryData &data, std::string &type)
 {
-  StarZone zone(input, name, "SfxPreview", m_password);
+  StarZone zone(input, name, "SfxPreview", getPassword());
   libstoff::DebugFile &ascii=zone.ascii();
   ascii.open(name);
   input->seek(0, librevenge::RVNG_SEEK_SET);
-  StarFileManager fileManager;
-  if (!fileManager.readSVGDI(zone)) {
+  if (!StarFileManager::readSVGDI(zone, data, type)) {
     STOFF_DEBUG_MSG(("StarObject::readSfxPreview: can not find the first image\n"));
     input->seek(0, librevenge::RVNG_SEEK_SET);
   }
@@ -49,6 +49,7 @@
 
 namespace StarObjectInternal
 {
+struct Context;
 struct State;
 }
 
@@ -75,27 +76,24 @@ public:
 
   //! try to parse data
   bool parse();
+  //! try to read only the document information: the SfxDocumentInfo zone
+  bool readDocumentInformation();
+  //! try to read only the document preview: the SfxPreview zone
+  bool readDocumentPreview(librevenge::RVNGBinaryData &data, std::string &type);
   //! returns the document kind
   STOFFDocument::Kind getDocumentKind() const;
   //! returns the document password (the password given by the user)
-  char const *getPassword() const
-  {
-    return m_password;
-  }
+  char const *getPassword() const;
+  //! returns the ole parser
+  std::shared_ptr<STOFFOLEParser> getOLEParser() const;
   //! returns the object directory
-  std::shared_ptr<STOFFOLEParser::OleDirectory> getOLEDirectory()
-  {
-    return m_directory;
-  }
+  std::shared_ptr<STOFFOLEParser::OleDirectory> getOLEDirectory();
   //! returns the attribute manager
   std::shared_ptr<StarAttributeManager> getAttributeManager();
   //! returns the format manager
   std::shared_ptr<StarFormatManager> getFormatManager();
   //! returns the meta data (filled by readSfxDocumentInformation)
-  librevenge::RVNGPropertyList const &getMetaData() const
-  {
-    return m_metaData;
-  }
+  librevenge::RVNGPropertyList const &getMetaData() const;
   //! returns the ith user meta data
   librevenge::RVNGString getUserNameMetaData(int i) const;
   // the document pool
@@ -122,8 +120,12 @@ protected:
   bool readPersistElements(STOFFInputStreamPtr input, std::string const &name);
   //! try to read the document information : "SfxDocumentInformation"
   bool readSfxDocumentInformation(STOFFInputStreamPtr input, std::string const &name);
-  //! try to read the preview : "SfxPreview"
-  bool readSfxPreview(STOFFInputStreamPtr input, std::string const &name);
+  /** try to read the preview : "SfxPreview"
+
+   \note data and type are filled with the biggest bitmap of the preview (if any) */
+  bool readSfxPreview(STOFFInputStreamPtr input, std::string const &name, librevenge::RVNGBinaryData &data, std::string &type);
+  //! returns the stream corresponding to an unparsed zone of the directory and marks this zone as parsed
+  STOFFInputStreamPtr openZone(std::string const &baseName, std::string &oleName);
   //! try to read the windows information : "SfxWindows"
   bool readSfxWindows(STOFFInputStreamPtr input, libstoff::DebugFile &ascii);
   //! try to read the "Star Framework Config File"
@@ -135,19 +137,18 @@ protected:
   // data
   //
 protected:
-  //! copy constructor
+  /** copy constructor: the copy shares the document context and, if duplicateState is set, the state
+      of orig (the state is duplicated when one of the objects modifies it) */
   StarObject(StarObject const &orig, bool duplicateState);
-  //! the document password
-  char const *m_password;
-  //! the ole parser
-  std::shared_ptr<STOFFOLEParser> m_oleParser;
-  //! the directory
-  std::shared_ptr<STOFFOLEParser::OleDirectory> m_directory;
+  //! returns the document context, duplicates it if it is shared with another object
+  StarObjectInternal::Context &getMutableContext();
+  //! returns the state, duplicates it if it is shared with another object
+  StarObjectInternal::State &getMutableState();
 
+  //! the document context: the password, the ole parser, the directory and the meta data
+  std::shared_ptr<StarObjectInternal::Context> m_context;
   //! the state
   std::shared_ptr<StarObjectInternal::State> m_state;
-  //! the meta data
-  librevenge::RVNGPropertyList m_metaData;
 
 private:
   StarObject(StarObject const &orig) = delete;
@@ -137,7 +137,7 @@ bool StarObjectChart::send(STOFFListenerPtr listener, STOFFFrameStyle const &fra
     return false;
   }
 
-  STOFFGraphicEncoder graphicEncoder;
+  STOFFGraphicEncoder graphicEncoder(getOLEDirectory() && getOLEDirectory()->m_input && getOLEDirectory()->m_input->recordEmbeddedObjects());
   std::vector<STOFFPageSpan> pageList;
   int numPages;
   if (!m_chartState->m_model->updatePageSpans(pageList, numPages, true))
@@ -94,12 +94,12 @@ StarObjectDraw::~StarObjectDraw()
 //
 ////////////////////////////////////////////////////////////
 
-bool StarObjectDraw::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages) const
+bool StarObjectDraw::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages, STOFFVec2i const &pageRange) const
 {
   if (!m_drawState->m_model)
     return false;
 
-  if (!m_drawState->m_model->updatePageSpans(pageSpan, numPages))
+  if (!m_drawState->m_model->updatePageSpans(pageSpan, numPages, false, pageRange))
     return false;
   m_drawState->m_numPages=numPages;
   return numPages>0;
@@ -119,6 +119,12 @@ bool StarObjectDraw::sendPages(STOFFGraphicListenerPtr listener)
   return m_drawState->m_model->sendPages(listener);
 }
 
+void StarObjectDraw::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  if (m_drawState->m_model)
+    m_drawState->m_model->extractText(extractor);
+}
+
 ////////////////////////////////////////////////////////////
 // main zone
 ////////////////////////////////////////////////////////////
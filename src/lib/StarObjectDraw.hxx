@@ -68,12 +68,16 @@ public:
   //! try to parse the current object
   bool parse();
 
-  /** try to update the page span (to create draw document)*/
-  bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages) const;
+  /** try to update the page span (to create draw document)
+
+   \note only the pages in pageRange are sent, see StarObjectModel::updatePageSpans */
+  bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages, STOFFVec2i const &pageRange=STOFFVec2i(0,-1)) const;
   //! try to send the different page
   bool sendPages(STOFFGraphicListenerPtr listener);
   //! try to send the master pages
   bool sendMasterPages(STOFFGraphicListenerPtr listener);
+  //! try to send the text of the pages to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
 
 protected:
   //! try to read a spreadsheet zone: StarDrawDocument .sdd
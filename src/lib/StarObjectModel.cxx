@@ -70,6 +70,22 @@ static bool convertUint8ListToBoolList(std::vector<int> const &orig, std::vector
   }
   return true;
 }
+//! small function used to skip a SdrObject zone: "DrOb'
+static bool skipSdrObject(StarZone &zone)
+{
+  STOFFInputStreamPtr input=zone.input();
+  std::string magic("");
+  long pos=input->tell();
+  for (int i=0; i<4; ++i) magic+=char(input->readULong(1));
+  input->seek(pos, librevenge::RVNG_SEEK_SET);
+  if (magic!="DrOb" || !zone.openSDRHeader(magic)) {
+    input->seek(pos, librevenge::RVNG_SEEK_SET);
+    return false;
+  }
+  input->seek(zone.getRecordLastPosition(), librevenge::RVNG_SEEK_SET);
+  zone.closeSDRHeader("SdrObject");
+  return true;
+}
 ////////////////////////////////////////
 //! Internal: class used to store a layer and its data
 class Layer
@@ -173,6 +189,7 @@ public:
     , m_layer()
     , m_layerSet()
     , m_objectList()
+    , m_objectPositions(0,0)
     , m_background()
   {
     for (int &border : m_borders) border=0;
@@ -200,6 +217,11 @@ public:
       STOFF_DEBUG_MSG(("StarObjectModelInternal::Page::updatePageSpan: sorry sending background object is not implemented\n"));
     }
   }
+  //! returns true if the objects are not decoded, ie. if they must be read by StarObjectModel::readPageObjects
+  bool hasLazyObjects() const
+  {
+    return m_objectPositions[1]>m_objectPositions[0];
+  }
   //! operator<<
   friend std::ostream &operator<<(std::ostream &o, Page const &page)
   {
@@ -218,6 +240,7 @@ public:
     o << "layer=[" << page.m_layer << "],";
     o << "layerSet=[" << page.m_layerSet << "],";
     if (page.m_background) o << "hasBackground,";
+    if (page.hasLazyObjects()) o << "objects[pos]=" << page.m_objectPositions << ",";
 #if 1
     for (auto &obj : page.m_objectList) {
       if (obj)
@@ -245,6 +268,8 @@ public:
   LayerSet m_layerSet;
   //! the list of object
   std::vector<std::shared_ptr<StarObjectSmallGraphic> > m_objectList;
+  //! the begin and end positions of the objects in the zone if they are decoded on demand
+  STOFFVec2l m_objectPositions;
   //! the background object
   std::shared_ptr<StarObjectSmallGraphic> m_background;
 };
@@ -262,6 +287,7 @@ struct State {
     , m_pageToSendList()
     , m_masterPageToSendSet()
     , m_idToObjectMap()
+    , m_zone()
   {
   }
   //! small operator<< to print the content of the state
@@ -330,6 +356,8 @@ struct State {
   std::set<int> m_masterPageToSendSet;
   //! a map objectId to object
   std::map<int, std::shared_ptr<StarObjectSmallGraphic> > m_idToObjectMap;
+  //! the zone used to decode the pages' objects on demand
+  std::shared_ptr<StarZone> m_zone;
 
 };
 
@@ -357,7 +385,7 @@ std::ostream &operator<<(std::ostream &o, StarObjectModel const &model)
 ////////////////////////////////////////////////////////////
 // send data
 ////////////////////////////////////////////////////////////
-bool StarObjectModel::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &number, bool usePage0) const
+bool StarObjectModel::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &number, bool usePage0, STOFFVec2i const &pageRange) const
 {
   m_modelState->m_pageToSendList.clear();
   m_modelState->m_masterPageToSendSet.clear();
@@ -374,12 +402,16 @@ bool StarObjectModel::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int
     return true;
   }
   auto numMasterPage=int(m_modelState->m_masterPageList.size());
+  int numPages=0;
   for (size_t i=0; i<m_modelState->m_pageList.size(); ++i) {
     if (!m_modelState->m_pageList[i])
       continue;
     auto const &page=*m_modelState->m_pageList[i];
     int id=page.getMasterPageId();
     if (id<=0 || (id&1)!=1) continue;
+    int pageNumber=numPages++;
+    if (pageNumber<pageRange[0]) continue;
+    if (pageRange[1]>=0 && pageNumber>pageRange[1]) break;
     m_modelState->m_pageToSendList.push_back(int(i));
     STOFFPageSpan ps;
     page.updatePageSpan(ps, relUnit);
@@ -436,6 +468,20 @@ bool StarObjectModel::sendPages(STOFFListenerPtr listener)
   return true;
 }
 
+void StarObjectModel::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  for (auto const &page : m_modelState->m_pageList) {
+    if (!page) continue;
+    std::vector<std::shared_ptr<StarObjectSmallGraphic> > lazyObjects;
+    if (page->hasLazyObjects())
+      readPageObjects(*page, lazyObjects);
+    for (auto const &obj : page->hasLazyObjects() ? lazyObjects : page->m_objectList) {
+      if (obj)
+        obj->extractText(extractor);
+    }
+  }
+}
+
 bool StarObjectModel::sendMasterPages(STOFFGraphicListenerPtr listener)
 {
   if (!listener) {
@@ -481,13 +527,42 @@ bool StarObjectModel::sendPage(int pageId, STOFFListenerPtr listener, bool maste
   STOFFFrameStyle frame;
   frame.m_position.m_anchorTo=STOFFPosition::Page;
   if (!masterPage) frame.m_position.m_propertyList.insert("text:anchor-page-number", pageId+1);
-  for (auto pag : page.m_objectList) {
+  // the lazy objects are released when the page is sent
+  std::vector<std::shared_ptr<StarObjectSmallGraphic> > lazyObjects;
+  if (page.hasLazyObjects())
+    readPageObjects(page, lazyObjects);
+  for (auto pag : page.hasLazyObjects() ? lazyObjects : page.m_objectList) {
     if (pag)
       pag->send(listener, frame, *this, masterPage);
   }
   return true;
 }
 
+bool StarObjectModel::readPageObjects(StarObjectModelInternal::Page const &page, std::vector<std::shared_ptr<StarObjectSmallGraphic> > &objects) const
+{
+  objects.clear();
+  if (!m_modelState->m_zone || !m_modelState->m_zone->input()) {
+    STOFF_DEBUG_MSG(("StarObjectModel::readPageObjects: can not find the zone\n"));
+    return false;
+  }
+  StarZone zone(*m_modelState->m_zone, page.m_objectPositions[1]);
+  STOFFInputStreamPtr input=zone.input();
+  long actPos=input->tell();
+  input->seek(page.m_objectPositions[0], librevenge::RVNG_SEEK_SET);
+  bool ok=true;
+  while (input->tell()+4<=page.m_objectPositions[1]) {
+    std::shared_ptr<StarObjectSmallGraphic> smallGraphic(new StarObjectSmallGraphic(*this, true));
+    if (!smallGraphic->readSdrObject(zone)) {
+      STOFF_DEBUG_MSG(("StarObjectModel::readPageObjects: can not read an object\n"));
+      ok=false;
+      break;
+    }
+    objects.push_back(smallGraphic);
+  }
+  input->seek(actPos, librevenge::RVNG_SEEK_SET);
+  return ok;
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -727,8 +802,16 @@ bool StarObjectModel::read(StarZone &zone)
       }
     }
     if ((magic=="DrPg" || magic=="DrMP")) {
-      auto page=readSdrPage(zone);
+      /* the first page is used by the drawing layers and the charts,
+         so only the following pages' objects are decoded when needed */
+      bool decodeObjects=magic=="DrMP" || m_modelState->m_pageList.empty();
+#ifdef DEBUG_WITH_FILES
+      decodeObjects=true;
+#endif
+      auto page=readSdrPage(zone, decodeObjects);
       if (page) {
+        if (page->hasLazyObjects() && !m_modelState->m_zone)
+          m_modelState->m_zone=std::make_shared<StarZone>(zone, input->size());
         if (magic=="DrPg")
           m_modelState->m_pageList.push_back(page);
         else
@@ -878,7 +961,7 @@ bool StarObjectModel::readSdrLayerSet(StarZone &zone, StarObjectModelInternal::L
   return true;
 }
 
-std::shared_ptr<StarObjectModelInternal::Page> StarObjectModel::readSdrPage(StarZone &zone)
+std::shared_ptr<StarObjectModelInternal::Page> StarObjectModel::readSdrPage(StarZone &zone, bool decodeObjects)
 {
   STOFFInputStreamPtr input=zone.input();
   // first check magic
@@ -1052,14 +1135,22 @@ std::shared_ptr<StarObjectModelInternal::Page> StarObjectModel::readSdrPage(Star
     ascFile.addNote(f.str().c_str());
   }
   // SdrObjList::Load
+  long const objectsPos=input->tell();
+  long endObjectsPos=objectsPos;
   while (ok) {
-    pos=input->tell();
+    pos=endObjectsPos=input->tell();
     if (pos+4>lastPos)
       break;
-    std::shared_ptr<StarObjectSmallGraphic> smallGraphic(new StarObjectSmallGraphic(*this, true));
-    if (smallGraphic->readSdrObject(zone)) {
-      page->m_objectList.push_back(smallGraphic);
-      continue;
+    if (!decodeObjects) {
+      if (StarObjectModelInternal::skipSdrObject(zone))
+        continue;
+    }
+    else {
+      std::shared_ptr<StarObjectSmallGraphic> smallGraphic(new StarObjectSmallGraphic(*this, true));
+      if (smallGraphic->readSdrObject(zone)) {
+        page->m_objectList.push_back(smallGraphic);
+        continue;
+      }
     }
 
     magic="";
@@ -1078,6 +1169,8 @@ std::shared_ptr<StarObjectModelInternal::Page> StarObjectModel::readSdrPage(Star
     input->seek(pos, librevenge::RVNG_SEEK_SET);
     break;
   }
+  if (!decodeObjects && endObjectsPos>objectsPos)
+    page->m_objectPositions=STOFFVec2l(objectsPos, endObjectsPos);
   if (ok && version>=16) {
     pos=input->tell();
     f.str("");
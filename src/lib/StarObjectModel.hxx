@@ -53,6 +53,7 @@ class Page;
 struct State;
 }
 
+class StarObjectSmallGraphic;
 class StarState;
 class StarZone;
 
@@ -75,14 +76,19 @@ public:
       \note this is used to retrieve an object in a .sdw's DrawingLawer stream
    */
   void updateObjectIds(std::set<long> &unusedId);
-  /** try to update the page span (to create draw document)*/
-  bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages, bool usePage0=false) const;
+  /** try to update the page span (to create draw document)
+
+   \note only the pages in pageRange (0-based, the last page is included, a negative last page means
+   all the following pages) and their master pages are sent by sendPages and sendMasterPages */
+  bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages, bool usePage0=false, STOFFVec2i const &pageRange=STOFFVec2i(0,-1)) const;
   //! try to send the master pages
   bool sendMasterPages(STOFFGraphicListenerPtr listener);
   //! try to send the different page
   bool sendPages(STOFFListenerPtr listener);
   //! try to send a page content
   bool sendPage(int pageId, STOFFListenerPtr listener, bool masterPage=false);
+  //! try to send the text of the pages' objects to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
   //! try to send an object
   bool sendObject(int id, STOFFListenerPtr listener, StarState const &state);
 
@@ -96,8 +102,12 @@ protected:
   bool readSdrLayer(StarZone &zone, StarObjectModelInternal::Layer &layer);
   //! try to read a SdrLayerSet zone: "DrLS'
   bool readSdrLayerSet(StarZone &zone, StarObjectModelInternal::LayerSet &layers);
-  //! try to read a Page/MasterPage zone: "DrPg'
-  std::shared_ptr<StarObjectModelInternal::Page> readSdrPage(StarZone &zone);
+  /** try to read a Page/MasterPage zone: "DrPg'
+
+   \note if decodeObjects is false, only the objects' positions are stored and the objects are decoded by readPageObjects */
+  std::shared_ptr<StarObjectModelInternal::Page> readSdrPage(StarZone &zone, bool decodeObjects=true);
+  //! try to decode the objects of a page whose objects were not decoded by readSdrPage
+  bool readPageObjects(StarObjectModelInternal::Page const &page, std::vector<std::shared_ptr<StarObjectSmallGraphic> > &objects) const;
   /* try to read a Master Page descriptor zone: "DrMP' and add it the master page descriptor */
   bool readSdrMPageDesc(StarZone &zone, StarObjectModelInternal::Page &page);
   /* try to read a list of Master Page zone: "DrML' and add them in the master page descriptors */
@@ -187,6 +187,18 @@ public:
     }
     return true;
   }
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const
+  {
+    if (m_textZone)
+      m_textZone->extractText(extractor);
+    else {
+      for (auto const &z : m_zones) {
+        if (z.m_text)
+          z.m_text->extractText(extractor);
+      }
+    }
+  }
   //! the version
   int m_version;
   //! the list of zones: version<=3
@@ -272,6 +284,10 @@ public:
     }
     return false;
   }
+  //! try to send the graphic's text to a text extractor
+  virtual void extractText(STOFFTextExtractorInterface &/*extractor*/) const
+  {
+  }
   //! the type
   int m_identifier;
 };
@@ -329,14 +345,14 @@ public:
   //! try to update the graphic style
   void updateStyle(StarState &state, STOFFListenerPtr /*listener*/) const
   {
-    state.m_frame.addStyleTo(state.m_graphic.m_propertyList);
+    state.m_frame->addStyleTo(state.m_graphic.edit().m_propertyList);
     if (m_flags[0] && m_flags[1])
-      state.m_graphic.m_propertyList.insert("style:protect", "position size");
+      state.m_graphic.edit().m_propertyList.insert("style:protect", "position size");
     else if (m_flags[0])
-      state.m_graphic.m_propertyList.insert("style:protect", "position");
+      state.m_graphic.edit().m_propertyList.insert("style:protect", "position");
     else if (m_flags[1])
-      state.m_graphic.m_propertyList.insert("style:protect", "size");
-    state.m_graphic.m_propertyList.insert("style:print-content", !m_flags[2]);
+      state.m_graphic.edit().m_propertyList.insert("style:protect", "size");
+    state.m_graphic.edit().m_propertyList.insert("style:print-content", !m_flags[2]);
     // todo noVisible as master ie hide in master
   }
   //! basic print function
@@ -412,7 +428,7 @@ public:
       auto const *mStyle=state.m_global->m_pool->findStyleWithFamily(m_sheetStyle, StarItemStyle::F_Paragraph);
       if (mStyle && !mStyle->m_names[0].empty()) {
         if (listener) state.m_global->m_pool->defineGraphicStyle(listener, mStyle->m_names[0], state.m_global->m_object);
-        state.m_graphic.m_propertyList.insert("librevenge:parent-display-name", mStyle->m_names[0]);
+        state.m_graphic.edit().m_propertyList.insert("librevenge:parent-display-name", mStyle->m_names[0]);
       }
       else if (mStyle) {
         for (auto it : mStyle->m_itemSet.m_whichToItemMap) {
@@ -493,6 +509,14 @@ public:
     listener->closeGroup();
     return true;
   }
+  //! try to send the child's text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const final
+  {
+    for (auto &child : m_child) {
+      if (child)
+        child->extractText(extractor);
+    }
+  }
   //! print object data
   friend std::ostream &operator<<(std::ostream &o, SdrGraphicGroup const &graph)
   {
@@ -583,19 +607,25 @@ public:
       position.setAnchor(STOFFPosition::Page);
     updateStyle(state, listener);
     // if (!state.m_graphic.m_hasBackground) state.m_graphic.m_propertyList.insert("draw:fill", "none"); checkme
-    state.m_graphic.m_propertyList.insert("draw:fill", "none");
-    state.m_graphic.m_propertyList.insert("draw:shadow", "hidden"); // the text is not shadowed
+    state.m_graphic.edit().m_propertyList.insert("draw:fill", "none");
+    state.m_graphic.edit().m_propertyList.insert("draw:shadow", "hidden"); // the text is not shadowed
     if (m_textDrehWink) {
       // checkme: this can not work for a text listener. We must create a rectangle with text instead
       STOFFVec2f const &orig=position.m_origin;
-      state.m_graphic.m_propertyList.insert("librevenge:rotate-cx", orig[0], librevenge::RVNG_POINT);
-      state.m_graphic.m_propertyList.insert("librevenge:rotate-cy", orig[1], librevenge::RVNG_POINT);
-      state.m_graphic.m_propertyList.insert("librevenge:rotate", -(m_textDrehWink/100.), librevenge::RVNG_GENERIC);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:rotate-cx", orig[0], librevenge::RVNG_POINT);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:rotate-cy", orig[1], librevenge::RVNG_POINT);
+      state.m_graphic.edit().m_propertyList.insert("librevenge:rotate", -(m_textDrehWink/100.), librevenge::RVNG_GENERIC);
     }
     std::shared_ptr<SubDocument> doc(new SubDocument(m_outlinerParaObject));
     listener->insertTextBox(frame, doc, state.m_graphic);
     return true;
   }
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const override
+  {
+    if (m_outlinerParaObject)
+      m_outlinerParaObject->extractText(extractor);
+  }
   //! print object data
   friend std::ostream &operator<<(std::ostream &o, SdrGraphicText const &graph)
   {
@@ -732,8 +762,9 @@ public:
     STOFFGraphicShape shape;
     shape.m_command=STOFFGraphicShape::C_Polyline;
     StarGraphicStruct::StarPolygon polygon;
+    polygon.reserve(m_captionPolygon.size());
     for (auto const &p : m_captionPolygon)
-      polygon.m_points.push_back(StarGraphicStruct::StarPolygon::Point(p, 0));
+      polygon.addPoint(p);
     librevenge::RVNGPropertyListVector path;
     polygon.addToPath(path, false, state.m_global->m_relativeUnit, state.m_global->m_offset);
     shape.m_propertyList.insert("svg:d", path);
@@ -915,8 +946,9 @@ public:
     shape.m_command=STOFFGraphicShape::C_Connector;
     size_t numFlags=m_edgePolygonFlags.size();
     StarGraphicStruct::StarPolygon polygon;
+    polygon.reserve(m_edgePolygon.size());
     for (size_t p=0; p<m_edgePolygon.size(); ++p)
-      polygon.m_points.push_back(StarGraphicStruct::StarPolygon::Point(m_edgePolygon[p], p<numFlags ? m_edgePolygonFlags[p] : 0));
+      polygon.addPoint(m_edgePolygon[p], p<numFlags ? m_edgePolygonFlags[p] : 0);
     librevenge::RVNGPropertyListVector path;
     polygon.addToPath(path, false, state.m_global->m_relativeUnit, state.m_global->m_offset);
     shape.m_propertyList.insert("svg:d", path);
@@ -1148,7 +1180,7 @@ public:
       return false;
     }
     StarState state(getState(object, listener, pos));
-    STOFFPosition &position=state.m_frame.m_position;
+    STOFFPosition &position=state.m_frame.edit().m_position;
     position=pos.m_position;
     position.setOrigin(state.convertPointInPoint(m_bdbox[0]));
     position.setSize(state.convertVectorInPoint(m_bdbox.size()));
@@ -1332,7 +1364,7 @@ bool SdrGraphicPath::send(STOFFListenerPtr &listener, STOFFFrameStyle const &pos
       shape.m_command=STOFFGraphicShape::C_Polyline;
       for (size_t i=0; i<2; ++i) {
         librevenge::RVNGPropertyList list;
-        auto pt=state.convertPointInPoint(m_pathPolygons[i].m_points[0].m_point);
+        auto pt=state.convertPointInPoint(m_pathPolygons[i].getPoint(0));
         list.insert("svg:x",pt[0], librevenge::RVNG_POINT);
         list.insert("svg:y",pt[1], librevenge::RVNG_POINT);
         vect.append(list);
@@ -1379,7 +1411,7 @@ bool SdrGraphicPath::send(STOFFListenerPtr &listener, STOFFFrameStyle const &pos
     shape.m_command=isClosed ? STOFFGraphicShape::C_Polygon : STOFFGraphicShape::C_Polyline;
     librevenge::RVNGPropertyList list;
     for (size_t i=0; i<m_pathPolygons[0].size(); ++i) {
-      auto pt=state.convertPointInPoint(m_pathPolygons[0].m_points[i].m_point);
+      auto pt=state.convertPointInPoint(m_pathPolygons[0].getPoint(i));
       list.insert("svg:x",pt[0], librevenge::RVNG_POINT);
       list.insert("svg:y",pt[1], librevenge::RVNG_POINT);
       vect.append(list);
@@ -1738,6 +1770,12 @@ bool StarObjectSmallGraphic::send(STOFFListenerPtr &listener, STOFFFrameStyle co
   return m_graphicState->m_graphic->send(listener, pos, object, inMasterPage);
 }
 
+void StarObjectSmallGraphic::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  if (m_graphicState->m_graphic)
+    m_graphicState->m_graphic->extractText(extractor);
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -2697,7 +2735,11 @@ bool StarObjectSmallGraphic::readSVDRObjectOLE(StarZone &zone, StarObjectSmallGr
       oleName=libstoff::getString(string);
   }
   if (ok) {
-    graphic.m_oleParser=m_oleParser;
+    graphic.m_oleParser=getOLEParser();
+    if (graphic.m_oleParser && !graphic.m_oleNames[0].empty()) {
+      auto dir=graphic.m_oleParser->getDirectory(graphic.m_oleNames[0].cstr());
+      if (dir) dir->m_referenced=true;
+    }
     bool objValid, hasGraphic;
     *input >> objValid >> hasGraphic;
     if (objValid) f << "obj[refValid],";
@@ -2774,10 +2816,11 @@ bool StarObjectSmallGraphic::readSVDRObjectPath(StarZone &zone, StarObjectSmallG
       }
       graphic.m_pathPolygons.push_back(StarGraphicStruct::StarPolygon());
       auto &polygon=graphic.m_pathPolygons.back();
+      polygon.reserve(size_t(n));
       for (int pt=0; pt<int(n); ++pt) {
         int dim[2];
         for (int &i : dim) i=int(input->readLong(4));
-        polygon.m_points.push_back(StarGraphicStruct::StarPolygon::Point(STOFFVec2i(dim[0],dim[1])));
+        polygon.addPoint(STOFFVec2i(dim[0],dim[1]));
       }
     }
   }
@@ -2802,14 +2845,14 @@ bool StarObjectSmallGraphic::readSVDRObjectPath(StarZone &zone, StarObjectSmallG
       }
       graphic.m_pathPolygons.push_back(StarGraphicStruct::StarPolygon());
       auto &polygon=graphic.m_pathPolygons.back();
-      polygon.m_points.resize(size_t(n));
+      polygon.resize(size_t(n));
       for (size_t pt=0; pt<size_t(n); ++pt) {
         int dim[2];
         for (int &i : dim) i=int(input->readLong(4));
-        polygon.m_points[pt].m_point=STOFFVec2i(dim[0],dim[1]);
+        polygon.setPoint(pt, STOFFVec2i(dim[0],dim[1]));
       }
       for (size_t pt=0; pt<size_t(n); ++pt)
-        polygon.m_points[pt].m_flags=int(input->readULong(1));
+        polygon.setFlag(pt, int(input->readULong(1)));
     }
     if (recOpened) {
       if (input->tell()!=zone.getRecordLastPosition()) {
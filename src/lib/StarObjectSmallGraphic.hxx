@@ -89,6 +89,8 @@ public:
   bool readSdrObject(StarZone &zone);
   //! try to send a object to the listener
   bool send(STOFFListenerPtr &listener, STOFFFrameStyle const &pos, StarObject &object, bool inPageMaster=false);
+  //! try to send the object's text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
   //! small operator<< to print the content of the small graphic object
   friend std::ostream &operator<<(std::ostream &o, StarObjectSmallGraphic const &graphic);
 
@@ -39,6 +39,8 @@
 
 #include <librevenge/librevenge.h>
 
+#include <libstaroffice/libstaroffice.hxx>
+
 #include "STOFFFont.hxx"
 #include "STOFFListener.hxx"
 #include "STOFFParagraph.hxx"
@@ -118,7 +120,7 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
     }
   }
   editState.m_paragraph=mainState.m_paragraph;
-  if (level>=0) editState.m_paragraph.m_listLevelIndex=level;
+  if (level>=0) editState.m_paragraph.edit().m_listLevelIndex=level;
   editState.m_font=mainState.m_font;
   for (auto it : m_itemSet.m_whichToItemMap) {
     if (!it.second || !it.second->m_attribute) continue;
@@ -152,9 +154,8 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
     }
     std::shared_ptr<SWFieldManagerInternal::Field> field;
     if (fontChange) {
-      STOFFFont &font=editState.m_font;
       editState.reinitializeLineData();
-      font=mainFont;
+      editState.m_font=mainFont;
       for (size_t f=0; f<numFonts; ++f) {
         if (m_charLimitList[f][0]>int(srcPos) || m_charLimitList[f][1]<=int(srcPos))
           continue;
@@ -172,6 +173,7 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
         STOFF_DEBUG_MSG(("StarObjectSmallTextInternal::Paragraph::send: sorry, sending content/field/flyCnt/footnote/refMark/link is not implemented\n"));
         first=false;
       }
+      STOFFFont const &font=editState.m_font.get();
       listener->setFont(font);
       if (font.m_lineBreak) {
         listener->insertEOL(true);
@@ -192,8 +194,18 @@ bool Paragraph::send(STOFFListenerPtr &listener, StarState &mainState, StarState
       listener->insertTab();
     else if (m_text[c]==0xa)
       listener->insertEOL(true);
-    else
-      listener->insertUnicode(m_text[c]);
+    else {
+      // sends all the following characters which do not need a font change
+      size_t last=c+1;
+      while (last<m_text.size() && m_text[last]!=0x9 && m_text[last]!=0xa) {
+        size_t nextPos=last<m_textSourcePosition.size() ? m_textSourcePosition[last] : m_textSourcePosition.empty() ? 0 : 10000;
+        if (posSetIt!=modPosSet.end() && *posSetIt <= nextPos)
+          break;
+        ++last;
+      }
+      listener->insertUnicodeRun(&m_text[c], last-c);
+      c=last-1;
+    }
   }
   return true;
 }
@@ -245,6 +257,14 @@ bool StarObjectSmallText::send(std::shared_ptr<STOFFListener> listener, int leve
   return true;
 }
 
+void StarObjectSmallText::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  for (auto const &para : m_textState->m_paragraphList) {
+    libstoff::extractText(para.m_text, extractor);
+    extractor.insertBreak();
+  }
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -68,6 +68,8 @@ public:
 
   //! try to send a small text zone
   bool send(std::shared_ptr<STOFFListener> listener, int level=-1);
+  //! sends the paragraphs' text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
 protected:
   //
   // low level
@@ -31,15 +31,22 @@
 * instead of those above.
 */
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 #include <librevenge/librevenge.h>
 
+#include <libstaroffice/libstaroffice.hxx>
+
 #include "StarAttribute.hxx"
 #include "StarCellFormula.hxx"
 #include "StarEncryption.hxx"
@@ -57,8 +64,10 @@
 #include "STOFFGraphicStyle.hxx"
 #include "STOFFOLEParser.hxx"
 #include "STOFFPageSpan.hxx"
+#include "STOFFParseControl.hxx"
 #include "STOFFSubDocument.hxx"
 #include "STOFFSpreadsheetListener.hxx"
+#include "STOFFStringStream.hxx"
 #include "STOFFTable.hxx"
 
 #include "StarFormatManager.hxx"
@@ -138,7 +147,7 @@ struct ScMultiRecord {
     return true;
   }
   //! try to close a zone
-  void close(std::string const &wh)
+  void close(char const *wh)
   try
   {
     if (!m_zoneOpened) {
@@ -173,7 +182,7 @@ struct ScMultiRecord {
     return m_endContentPos>0;
   }
   //! try to go to the new content positon
-  bool openContent(std::string const &wh)
+  bool openContent(char const *wh)
   {
     if (m_endContentPos>0) {
       STOFF_DEBUG_MSG(("StarObjectSpreadsheetInternal::ScMultiRecord::openContent: argh, the current content is not closed, let close it\n"));
@@ -189,7 +198,7 @@ struct ScMultiRecord {
     return true;
   }
   //! try to go to the new content positon
-  bool closeContent(std::string const &wh)
+  bool closeContent(char const *wh)
   {
     if (m_endContentPos<=0) {
       STOFF_DEBUG_MSG(("StarObjectSpreadsheetInternal::ScMultiRecord::closeContent: no content opened\n"));
@@ -220,6 +229,11 @@ struct ScMultiRecord {
     }
     return m_endContentPos;
   }
+  //! returns the end of data position, ie. the position where the remaining data can be skipped
+  long getDataLastPosition() const
+  {
+    return m_endPos;
+  }
 
   //! basic operator<< ; print header data
   friend std::ostream &operator<<(std::ostream &o, ScMultiRecord const &r)
@@ -299,37 +313,10 @@ public:
   //! constructor
   RowContent()
     : m_colToCellMap()
-    , m_colToAttributeMap()
-  {
-  }
-  //! try to compress the item list and create a attribute list
-  void compressItemList()
   {
-    std::map<STOFFVec2i,std::shared_ptr<StarAttribute> > oldMap=m_colToAttributeMap;
-    std::map<STOFFVec2i,std::shared_ptr<StarAttribute> >::const_iterator it=oldMap.begin();
-    m_colToAttributeMap.clear();
-
-    std::shared_ptr<StarAttribute> actAttribute;
-    STOFFVec2i actPos(0,-1);
-    while (it!=oldMap.end()) {
-      // first check for not filled row
-      std::shared_ptr<StarAttribute> newAttrib=it->second;
-      if (it->first[0]!=actPos[1]+1 || newAttrib.get()!=actAttribute.get()) {
-        if (actAttribute)
-          m_colToAttributeMap[actPos]=actAttribute;
-        actAttribute=newAttrib;
-        actPos=STOFFVec2i(it->first[0], it->first[0]-1);
-      }
-      actPos[1]=it->first[1];
-      ++it;
-    }
-    if (actAttribute)
-      m_colToAttributeMap[actPos]=actAttribute;
   }
   //! map col -> cell
   std::map<int, std::shared_ptr<Cell> > m_colToCellMap;
-  //! map col -> attribute
-  std::map<STOFFVec2i, std::shared_ptr<StarAttribute> > m_colToAttributeMap;
 };
 
 ////////////////////////////////////////
@@ -346,11 +333,37 @@ public:
     , m_colWidthList()
     , m_rowHeightMap()
     , m_rowToRowContentMap()
+    , m_colToAttributeRunsMap()
     , m_badCell()
+    , m_formulaCache()
+    , m_readOnlyOptions(false)
+    , m_useReadWindow(false)
+    , m_readWindow()
   {
   }
   //! destructor
   ~Table() override;
+  //! only reads the cells of window (and the attributes of the previous columns), see STOFFDocument::parse
+  void setReadWindow(STOFFBox2i const &window)
+  {
+    m_useReadWindow=true;
+    m_readWindow=window;
+  }
+  //! returns true if the cells' data of a column must be read
+  bool readColumnData(int column) const
+  {
+    return !m_readOnlyOptions && (!m_useReadWindow || (column>=m_readWindow.min()[0] && column<=m_readWindow.max()[0]));
+  }
+  //! returns true if the column must be read, the attributes of the columns before the window are needed to retrieve the merged cells
+  bool readColumn(int column) const
+  {
+    return !m_readOnlyOptions && (!m_useReadWindow || column<=m_readWindow.max()[0]);
+  }
+  //! returns the last row whose cells must be read
+  int getLastReadRow() const
+  {
+    return m_useReadWindow ? m_readWindow.max()[1] : getMaxRows();
+  }
   //! returns the load version
   int getLoadingVersion() const
   {
@@ -392,6 +405,34 @@ public:
       return float(rIt->second)/20.f;
     return 12.f;
   }
+  //! returns the column's attributes of a row: map (min col, max col) -> attribute
+  void getRowAttributes(int row, std::map<STOFFVec2i, std::shared_ptr<StarAttribute> > &colToAttributeMap) const
+  {
+    colToAttributeMap.clear();
+    std::shared_ptr<StarAttribute> actAttribute;
+    STOFFVec2i actCols(0,-1);
+    for (auto const &cIt : m_colToAttributeRunsMap) {
+      auto const &runs=cIt.second;
+      auto it=runs.lower_bound(STOFFVec2i(-1,row));
+      if (it==runs.end() || it->first[0]>row || !it->second)
+        continue;
+      if (cIt.first!=actCols[1]+1 || it->second.get()!=actAttribute.get()) {
+        if (actAttribute)
+          colToAttributeMap[actCols]=actAttribute;
+        actAttribute=it->second;
+        actCols[0]=cIt.first;
+      }
+      actCols[1]=cIt.first;
+    }
+    if (actAttribute)
+      colToAttributeMap[actCols]=actAttribute;
+  }
+  //! returns true if a row contains some cells
+  bool hasCells(int row) const
+  {
+    auto it=m_rowToRowContentMap.lower_bound(STOFFVec2i(-1,row));
+    return it!=m_rowToRowContentMap.end() && it->first[0]<=row && !it->second.m_colToCellMap.empty();
+  }
   //! returns a row content
   RowContent *getRow(int row)
   {
@@ -475,14 +516,69 @@ public:
   std::map<STOFFVec2i, int> m_rowHeightMap;
   //! map (min row, max row) -> rowContent
   std::map<STOFFVec2i, RowContent> m_rowToRowContentMap;
+  //! map col -> (map (min row, max row) -> attribute)
+  std::map<int, std::map<STOFFVec2i, std::shared_ptr<StarAttribute> > > m_colToAttributeRunsMap;
   //! a cell uses to return an empty cell
   Cell m_badCell;
+  //! the cache of the already decoded formulas
+  StarCellFormula::FormulaCache m_formulaCache;
+  //! a flag to know if only the table options (name, page style, ...) must be read
+  bool m_readOnlyOptions;
+  //! a flag to know if only the cells of m_readWindow must be read
+  bool m_useReadWindow;
+  //! the cells to read: 0-based, the last column and row are included
+  STOFFBox2i m_readWindow;
 };
 
 Table::~Table()
 {
 }
 
+/** Internal: adds to rowSet the limits of the runs of rows of map: (min row, max row) -> T
+    which intersect the rows minRow...maxRow (or all the runs if maxRow<minRow) */
+template<class T>
+void addRowLimits(std::map<STOFFVec2i, T> const &map, int minRow, int maxRow, std::set<int> &rowSet)
+{
+  if (maxRow<minRow) {
+    for (auto const &it : map) {
+      rowSet.insert(it.first[0]);
+      rowSet.insert(it.first[1]+1);
+    }
+    return;
+  }
+  rowSet.insert(minRow);
+  rowSet.insert(maxRow+1);
+  // the runs are sorted by rows, so we can begin with the run containing minRow
+  for (auto it=map.lower_bound(STOFFVec2i(-1,minRow)); it!=map.end() && it->first[0]<=maxRow; ++it) {
+    rowSet.insert(std::max(it->first[0], minRow));
+    rowSet.insert(std::min(it->first[1], maxRow)+1);
+  }
+}
+
+////////////////////////////////////////
+//! Internal: a table record of the StarCalcDocument stream, stored to be decoded once the document is read
+struct TableRecord {
+  //! constructor
+  TableRecord(std::shared_ptr<Table> const &table, STOFFInputStreamPtr const &input, long pos, StarEncoding::Encoding encoding, int guiType)
+    : m_table(table)
+    , m_input(input)
+    , m_position(pos)
+    , m_encoding(encoding)
+    , m_guiType(guiType)
+  {
+  }
+  //! the table
+  std::shared_ptr<Table> m_table;
+  //! the input
+  STOFFInputStreamPtr m_input;
+  //! the record position
+  long m_position;
+  //! the zone encoding when the record is found
+  StarEncoding::Encoding m_encoding;
+  //! the zone GUI type when the record is found
+  int m_guiType;
+};
+
 ////////////////////////////////////////
 //! Internal: the state of a StarObjectSpreadsheet
 struct State {
@@ -490,18 +586,30 @@ struct State {
   State()
     : m_model()
     , m_tableList()
+    , m_tableRecordList()
     , m_sheetNames()
     , m_pageStyle("")
+    , m_cellWindowSheet(-1)
+    , m_cellWindow()
+    , m_sharedDataMutex()
   {
   }
   //! the model
   std::shared_ptr<StarObjectModel> m_model;
   //! the actual table
   std::vector<std::shared_ptr<Table> > m_tableList;
+  //! the list of table records which are not decoded
+  std::vector<TableRecord> m_tableRecordList;
   //! the sheet names
   std::vector<librevenge::RVNGString> m_sheetNames;
   //! the main page style
   librevenge::RVNGString m_pageStyle;
+  //! the sheet whose cells are sent (if positive), the other sheets are not decoded
+  int m_cellWindowSheet;
+  //! the window of cells to decode in m_cellWindowSheet
+  STOFFBox2i m_cellWindow;
+  //! the mutex used to protect the pools, ... when the tables are decoded concurrently
+  std::mutex m_sharedDataMutex;
 };
 
 ////////////////////////////////////////
@@ -561,6 +669,12 @@ StarObjectSpreadsheet::~StarObjectSpreadsheet()
   cleanPools();
 }
 
+void StarObjectSpreadsheet::setCellWindow(int sheet, STOFFBox2i const &window)
+{
+  m_spreadsheetState->m_cellWindowSheet=sheet;
+  m_spreadsheetState->m_cellWindow=window;
+}
+
 ////////////////////////////////////////////////////////////
 //
 // send data
@@ -605,7 +719,7 @@ bool StarObjectSpreadsheet::updatePageSpans(std::vector<STOFFPageSpan> &pageSpan
   return true;
 }
 
-bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener)
+bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener, int sheetId, STOFFBox2i const &window)
 {
   if (m_spreadsheetState->m_tableList.empty() || !listener) {
     STOFF_DEBUG_MSG(("StarObjectSpreadsheet::send: can not find the table\n"));
@@ -620,31 +734,52 @@ bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener)
       m_spreadsheetState->m_sheetNames.push_back(t->m_name);
   }
 
-  for (size_t t=0; t<m_spreadsheetState->m_tableList.size(); ++t) {
-    if (t) listener->insertBreak(STOFFListener::PageBreak);
+  bool const useWindow=sheetId>=0;
+  if (useWindow && (sheetId>=int(m_spreadsheetState->m_tableList.size()) || !m_spreadsheetState->m_tableList[size_t(sheetId)])) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::send: can not find the sheet %d\n", sheetId));
+    return false;
+  }
+  // the rows to send: all the rows or only the window's rows
+  int const minRow=useWindow ? window.min()[1] : 0;
+  int const maxRow=useWindow ? window.max()[1] : -1;
+  STOFFVec2i const columns=useWindow ? STOFFVec2i(window.min()[0], window.max()[0]) : STOFFVec2i(0,-1);
+  size_t const firstTable=useWindow ? size_t(sheetId) : 0;
+  size_t const lastTable=useWindow ? size_t(sheetId)+1 : m_spreadsheetState->m_tableList.size();
+  for (size_t t=firstTable; t<lastTable; ++t) {
+    if (t>firstTable) listener->insertBreak(STOFFListener::PageBreak);
     if (!m_spreadsheetState->m_tableList[t]) continue;
     StarObjectSpreadsheetInternal::Table &sheet=*m_spreadsheetState->m_tableList[t];
     std::vector<int> repeated;
     std::vector<float> widths=sheet.getColumnWidths(repeated);
     listener->openSheet(widths, librevenge::RVNG_INCH, repeated, sheet.m_name);
-    if (m_spreadsheetState->m_model)
+    if (m_spreadsheetState->m_model && !useWindow)
       m_spreadsheetState->m_model->sendPage(int(t), listener);
 
     /* create a set to know which row needed to be send, each value of
        the set corresponding to a position where the rows change
        excepted the last position */
     std::set<int> newRowSet;
-    for (auto it : sheet.m_rowToRowContentMap) {
-      STOFFVec2i const &rows=it.first;
-      newRowSet.insert(rows[0]);
-      newRowSet.insert(rows[1]+1);
-    }
-    for (auto it : sheet.m_rowHeightMap) {
-      STOFFVec2i const &rows=it.first;
-      newRowSet.insert(rows[0]);
-      newRowSet.insert(rows[1]+1);
-    }
-
+    StarObjectSpreadsheetInternal::addRowLimits(sheet.m_rowToRowContentMap, minRow, maxRow, newRowSet);
+    StarObjectSpreadsheetInternal::addRowLimits(sheet.m_rowHeightMap, minRow, maxRow, newRowSet);
+    for (auto const &cIt : sheet.m_colToAttributeRunsMap) {
+      if (useWindow && (cIt.first<columns[0] || cIt.first>columns[1])) continue;
+      StarObjectSpreadsheetInternal::addRowLimits(cIt.second, minRow, maxRow, newRowSet);
+    }
+    // the merged cells which begin outside the window are sent clipped: position -> (anchor, span)
+    std::map<STOFFVec2i, std::pair<STOFFVec2i, STOFFVec2i> > clippedCellMap;
+    if (useWindow) {
+      findClippedMergedCells(sheet, window, clippedCellMap);
+      for (auto const &it : clippedCellMap) {
+        newRowSet.insert(it.first[1]);
+        newRowSet.insert(it.first[1]+1);
+      }
+    }
+    auto hasClippedCells=[&clippedCellMap](int row) {
+      auto it=clippedCellMap.lower_bound(STOFFVec2i(-1,row));
+      return it!=clippedCellMap.end() && it->first[1]==row;
+    };
+
+    std::map<STOFFVec2i, std::shared_ptr<StarAttribute> > attributes, nextAttributes;
     for (auto it=newRowSet.begin(); it!=newRowSet.end();) {
       int row=*(it++);
       if (row<0) {
@@ -653,8 +788,36 @@ bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener)
       }
       if (it==newRowSet.end())
         break;
-      listener->openSheetRow(sheet.getRowHeight(row), librevenge::RVNG_POINT, *it-row);
-      sendRow(int(t), row, listener);
+      float height=sheet.getRowHeight(row);
+      if (!sheet.hasCells(row) && !hasClippedCells(row)) {
+        // look for the following rows which are identical: no cell, same height and same attributes
+        sheet.getRowAttributes(row, attributes);
+        for (auto nextIt=std::next(it); nextIt!=newRowSet.end(); ++nextIt) {
+          int nextRow=*it;
+          if (sheet.hasCells(nextRow) || hasClippedCells(nextRow) || sheet.getRowHeight(nextRow)<height || sheet.getRowHeight(nextRow)>height)
+            break;
+          sheet.getRowAttributes(nextRow, nextAttributes);
+          if (attributes!=nextAttributes)
+            break;
+          it=nextIt;
+        }
+      }
+      listener->openSheetRow(height, librevenge::RVNG_POINT, *it-row);
+      if (!hasClippedCells(row))
+        sendRow(int(t), row, listener, columns);
+      else {
+        // send the cells before each clipped merged cell, then the clipped cell
+        int firstCol=columns[0];
+        for (auto cIt=clippedCellMap.lower_bound(STOFFVec2i(-1,row)); cIt!=clippedCellMap.end() && cIt->first[1]==row; ++cIt) {
+          int col=cIt->first[0];
+          if (firstCol<col)
+            sendRow(int(t), row, listener, STOFFVec2i(firstCol, col-1));
+          sendMergedCell(int(t), cIt->second.first, STOFFBox2i(cIt->first, cIt->first+cIt->second.second-STOFFVec2i(1,1)), listener);
+          firstCol=col+1;
+        }
+        if (firstCol<=columns[1])
+          sendRow(int(t), row, listener, STOFFVec2i(firstCol, columns[1]));
+      }
       listener->closeSheetRow();
     }
     listener->closeSheet();
@@ -663,7 +826,7 @@ bool StarObjectSpreadsheet::send(STOFFSpreadsheetListenerPtr listener)
   return true;
 }
 
-bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListenerPtr listener)
+bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListenerPtr listener, STOFFVec2i const &columns)
 {
   if (!listener || table<0 || table>=int(m_spreadsheetState->m_tableList.size()) || !m_spreadsheetState->m_tableList[size_t(table)]) {
     STOFF_DEBUG_MSG(("StarObjectSpreadsheet::send: can not find the table %d\n", table));
@@ -671,23 +834,37 @@ bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListener
   }
   auto &sheet=*m_spreadsheetState->m_tableList[size_t(table)];
   auto *rowC=sheet.getRow(row);
-  if (!rowC) return true;
-  rowC->compressItemList();
+  // the column's attributes are stored by runs, retrieve the attributes of this row
+  std::map<STOFFVec2i, std::shared_ptr<StarAttribute> > colToAttributeMap;
+  sheet.getRowAttributes(row, colToAttributeMap);
+  bool const useColumns=columns[0]<=columns[1];
+  if (useColumns && !colToAttributeMap.empty()) {
+    // only keeps the part of the runs which are in columns
+    std::map<STOFFVec2i, std::shared_ptr<StarAttribute> > clippedMap;
+    for (auto const &it : colToAttributeMap) {
+      STOFFVec2i cols(std::max(it.first[0], columns[0]), std::min(it.first[1], columns[1]));
+      if (cols[0]<=cols[1])
+        clippedMap[cols]=it.second;
+    }
+    colToAttributeMap.swap(clippedMap);
+  }
+  if (!rowC && colToAttributeMap.empty()) return true;
 
   // we need to go through the row style list and the cell list in parallel
   bool checkStyle=false;
   int actStyleCol=0;
   std::map<STOFFVec2i, std::shared_ptr<StarAttribute> >::const_iterator sIt;
-  if (!rowC->m_colToAttributeMap.empty()) {
+  if (!colToAttributeMap.empty()) {
     checkStyle=true;
-    sIt=rowC->m_colToAttributeMap.begin();
+    sIt=colToAttributeMap.begin();
     actStyleCol=sIt->first[0];
   }
   bool checkCell=false;
-  std::map<int, std::shared_ptr<StarObjectSpreadsheetInternal::Cell> >::iterator cIt;
-  if (!rowC->m_colToCellMap.empty()) {
-    checkCell=true;
-    cIt=rowC->m_colToCellMap.begin();
+  std::map<int, std::shared_ptr<StarObjectSpreadsheetInternal::Cell> >::iterator cIt, cEndIt;
+  if (rowC && !rowC->m_colToCellMap.empty()) {
+    cIt=useColumns ? rowC->m_colToCellMap.lower_bound(columns[0]) : rowC->m_colToCellMap.begin();
+    cEndIt=useColumns ? rowC->m_colToCellMap.upper_bound(columns[1]) : rowC->m_colToCellMap.end();
+    checkCell=cIt!=cEndIt;
   }
 
   StarObjectSpreadsheetInternal::Cell emptyCell;
@@ -695,7 +872,7 @@ bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListener
     int newCol=checkCell ? cIt->first : -1;
     if (checkStyle && sIt->first[1] < actStyleCol) {
       ++sIt;
-      checkStyle=sIt!=rowC->m_colToAttributeMap.end();
+      checkStyle=sIt!=colToAttributeMap.end();
       actStyleCol=checkStyle ? sIt->first[0] : -1;
     }
     if (checkStyle && (!checkCell || actStyleCol<newCol)) {
@@ -714,12 +891,75 @@ bool StarObjectSpreadsheet::sendRow(int table, int row, STOFFSpreadsheetListener
     else
       sendCell(cIt->second ? *cIt->second : emptyCell, nullptr, table, 1, listener);
     ++cIt;
-    checkCell=cIt!=rowC->m_colToCellMap.end();
+    checkCell=cIt!=cEndIt;
   }
   return true;
 }
 
-bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener)
+void StarObjectSpreadsheet::findClippedMergedCells(StarObjectSpreadsheetInternal::Table const &sheet, STOFFBox2i const &window,
+    std::map<STOFFVec2i, std::pair<STOFFVec2i, STOFFVec2i> > &posToAnchorSpanMap)
+{
+  posToAnchorSpanMap.clear();
+  auto pool=findItemPool(StarItemPool::T_SpreadsheetPool, false);
+  std::map<StarAttribute const *, STOFFVec2i> attributeToSpanMap;
+  for (auto const &cIt : sheet.m_colToAttributeRunsMap) {
+    int const col=cIt.first;
+    if (col>window.max()[0]) break;
+    // the runs are sorted by rows
+    for (auto const &rIt : cIt.second) {
+      STOFFVec2i const &rows=rIt.first;
+      if (rows[0]>window.max()[1]) break;
+      if (!rIt.second) continue;
+      auto sIt=attributeToSpanMap.find(rIt.second.get());
+      if (sIt==attributeToSpanMap.end()) {
+        StarState state(pool.get(), *this);
+        rIt.second->addTo(state);
+        sIt=attributeToSpanMap.insert(std::make_pair(rIt.second.get(), state.m_cell->m_numberCellSpanned)).first;
+      }
+      STOFFVec2i const &span=sIt->second;
+      if (span[0]<1 || span[1]<1 || (span[0]==1 && span[1]==1) || col+span[0]-1<window.min()[0])
+        continue;
+      for (int row=std::max(rows[0], window.min()[1]-span[1]+1); row<=std::min(rows[1], window.max()[1]); ++row) {
+        if (col>=window.min()[0] && row>=window.min()[1]) // the next anchors are in the window
+          break;
+        STOFFBox2i area(STOFFVec2i(col,row), STOFFVec2i(col,row)+span-STOFFVec2i(1,1));
+        area=area.getIntersection(window);
+        if (area.min()[0]>area.max()[0] || area.min()[1]>area.max()[1])
+          continue;
+        posToAnchorSpanMap[area.min()]=std::make_pair(STOFFVec2i(col,row), area.size()+STOFFVec2i(1,1));
+      }
+    }
+  }
+}
+
+bool StarObjectSpreadsheet::sendMergedCell(int table, STOFFVec2i const &anchor, STOFFBox2i const &area, STOFFSpreadsheetListenerPtr listener)
+{
+  if (!listener || table<0 || table>=int(m_spreadsheetState->m_tableList.size()) || !m_spreadsheetState->m_tableList[size_t(table)]) {
+    STOFF_DEBUG_MSG(("StarObjectSpreadsheet::sendMergedCell: can not find the table %d\n", table));
+    return false;
+  }
+  auto &sheet=*m_spreadsheetState->m_tableList[size_t(table)];
+  // retrieve the anchor cell (if its content has been read) and its attribute
+  StarObjectSpreadsheetInternal::Cell cell;
+  auto *rowC=sheet.getRow(anchor[1]);
+  if (rowC) {
+    auto cIt=rowC->m_colToCellMap.find(anchor[0]);
+    if (cIt!=rowC->m_colToCellMap.end() && cIt->second)
+      cell=*cIt->second;
+  }
+  cell.setPosition(area.min());
+  StarAttribute *attrib=nullptr;
+  auto colIt=sheet.m_colToAttributeRunsMap.find(anchor[0]);
+  if (colIt!=sheet.m_colToAttributeRunsMap.end()) {
+    auto rIt=colIt->second.lower_bound(STOFFVec2i(-1,anchor[1]));
+    if (rIt!=colIt->second.end() && rIt->first[0]<=anchor[1])
+      attrib=rIt->second.get();
+  }
+  return sendCell(cell, attrib, table, 1, listener, area.size()+STOFFVec2i(1,1));
+}
+
+bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener,
+                                     STOFFVec2i const &span)
 {
   if (!listener) {
     STOFF_DEBUG_MSG(("StarObjectSpreadsheet::send: can not find the listener\n"));
@@ -734,6 +974,8 @@ bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell,
     // checkme: we need the pool here
     getFormatManager()->updateNumberingProperties(cell);
   }
+  if (span[0]>0 && span[1]>0)
+    cell.getCellStyle().m_numberCellSpanned=span;
   if (!cell.m_content.m_formula.empty())
     StarCellFormula::updateFormula(cell.m_content, m_spreadsheetState->m_sheetNames, table);
 
@@ -750,6 +992,31 @@ bool StarObjectSpreadsheet::sendCell(StarObjectSpreadsheetInternal::Cell &cell,
   return true;
 }
 
+void StarObjectSpreadsheet::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  for (auto const &sheet : m_spreadsheetState->m_tableList) {
+    if (!sheet) continue;
+    for (auto const &rIt : sheet->m_rowToRowContentMap) {
+      for (auto const &cIt : rIt.second.m_colToCellMap) {
+        if (!cIt.second) continue;
+        auto const &cell=*cIt.second;
+        if (cell.m_content.m_contentType==STOFFCellContent::C_TEXT_BASIC && !cell.m_content.m_text.empty()) {
+          libstoff::extractText(cell.m_content.m_text, extractor);
+          extractor.insertBreak();
+        }
+        else if (cell.m_content.m_contentType==STOFFCellContent::C_TEXT && cell.m_textZone)
+          cell.m_textZone->extractText(extractor);
+        if (cell.m_hasNote && !cell.m_notes[0].empty()) {
+          extractor.insertText(cell.m_notes[0].cstr(), cell.m_notes[0].size());
+          extractor.insertBreak();
+        }
+      }
+    }
+  }
+  if (m_spreadsheetState->m_model)
+    m_spreadsheetState->m_model->extractText(extractor);
+}
+
 ////////////////////////////////////////////////////////////
 // main zone
 ////////////////////////////////////////////////////////////
@@ -805,8 +1072,10 @@ bool StarObjectSpreadsheet::parse()
     STOFF_DEBUG_MSG(("StarObjectSpreadsheet::parser: can not find the main calc document\n"));
     return false;
   }
-  else
+  else {
     readCalcDocument(mainOle,mainName);
+    readSCTables(mainName);
+  }
   return true;
 }
 
@@ -859,7 +1128,24 @@ try
       std::shared_ptr<StarObjectSpreadsheetInternal::Table> table;
       table.reset(new StarObjectSpreadsheetInternal::Table(version, maxRow));
       m_spreadsheetState->m_tableList.push_back(table);
+#if defined(DEBUG_WITH_FILES)
+      // decode the table now to keep the debug file complete
       ok=readSCTable(zone, *table);
+#else
+      // only index the table, it will be decoded by readSCTables
+      long tablePos=input->tell();
+      ok=zone.openSCRecord();
+      if (!ok) {
+        input->seek(tablePos, librevenge::RVNG_SEEK_SET);
+        break;
+      }
+      m_spreadsheetState->m_tableRecordList.push_back
+      (StarObjectSpreadsheetInternal::TableRecord(table, input, tablePos, zone.getEncoding(), zone.getGuiType()));
+      // the table's bytes will be counted by the zone which decodes it
+      zone.setParseControlPosition(zone.getRecordLastPosition());
+      input->seek(zone.getRecordLastPosition(), librevenge::RVNG_SEEK_SET);
+      zone.closeSCRecord("SCTable");
+#endif
       break;
     }
     case 0x4224: {
@@ -1781,6 +2067,126 @@ bool StarObjectSpreadsheet::readSfxStyleSheets(STOFFInputStreamPtr input, std::s
 // Low level
 //
 ////////////////////////////////////////////////////////////
+bool StarObjectSpreadsheet::readSCTables(std::string const &name)
+{
+  auto const &records=m_spreadsheetState->m_tableRecordList;
+  if (records.empty())
+    return true;
+  int const windowSheet=m_spreadsheetState->m_cellWindowSheet;
+  if (windowSheet>=0) {
+    // only the window's cells are needed, the other tables are only read to retrieve their names
+    auto const &tables=m_spreadsheetState->m_tableList;
+    for (size_t t=0; t<tables.size(); ++t) {
+      if (!tables[t]) continue;
+      if (int(t)==windowSheet)
+        tables[t]->setReadWindow(m_spreadsheetState->m_cellWindow);
+      else
+        tables[t]->m_readOnlyOptions=true;
+    }
+  }
+  auto numThreads=size_t(std::thread::hardware_concurrency());
+  numThreads=std::min(numThreads, records.size());
+  bool ok=true;
+  /* the stream data are read once and shared (read only) between the threads,
+     each thread reading them with its own offset; the next table to decode
+     being given by nextRecord */
+  std::map<STOFFInputStream const *, std::shared_ptr<std::vector<unsigned char> const> > inputToDataMap;
+  for (size_t r=0; numThreads>1 && r<records.size(); ++r) {
+    auto const &record=records[r];
+    if (!record.m_input || inputToDataMap.find(record.m_input.get())!=inputToDataMap.end())
+      continue;
+    // read directly the librevenge stream, so that the data are retrieved even if the binary data are skipped
+    auto stream=record.m_input->input();
+    long const size=record.m_input->size();
+    unsigned long numRead=0;
+    unsigned char const *data=(stream && size>0 && stream->seek(0, librevenge::RVNG_SEEK_SET)==0) ?
+                              stream->read(static_cast<unsigned long>(size), numRead) : nullptr;
+    record.m_input->seek(0, librevenge::RVNG_SEEK_SET);
+    if (!data || numRead!=static_cast<unsigned long>(size)) {
+      STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCTables: can not retrieve the stream data, decode the tables sequentially\n"));
+      numThreads=1;
+      break;
+    }
+    inputToDataMap[record.m_input.get()]=std::make_shared<std::vector<unsigned char> const>(data, data+numRead);
+  }
+  if (numThreads<=1) {
+    for (auto const &record : records)
+      ok=readSCTable(record, record.m_input, name) && ok;
+  }
+  else {
+    std::atomic<size_t> nextRecord(0);
+    std::atomic<bool> allOk(true), cancelled(false);
+    auto decode=[this, &records, &inputToDataMap, &nextRecord, &allOk, &cancelled, &name]() {
+      std::map<STOFFInputStream const *, STOFFInputStreamPtr> inputMap;
+      for (size_t r=nextRecord++; r<records.size(); r=nextRecord++) {
+        auto const &record=records[r];
+        if (!record.m_input) {
+          allOk=false;
+          continue;
+        }
+        auto &input=inputMap[record.m_input.get()];
+        if (!input) {
+          // do not use STOFFInputStream::get as the data's stream can not be shared between threads
+          std::shared_ptr<librevenge::RVNGInputStream> stream(new STOFFStringStream(inputToDataMap.find(record.m_input.get())->second));
+          input.reset(new STOFFInputStream(stream, record.m_input->readInverted()));
+          input->setSkipBinaryData(record.m_input->skipBinaryData());
+          input->setRecordEmbeddedObjects(record.m_input->recordEmbeddedObjects());
+          input->setParseControl(record.m_input->getParseControl());
+        }
+        try {
+          if (!readSCTable(record, input, name))
+            allOk=false;
+        }
+        catch (libstoff::ParseException const &) {
+          // the parsing is cancelled, stop decoding the tables
+          cancelled=true;
+          nextRecord=records.size();
+          return;
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    try {
+      for (size_t i=1; i<numThreads; ++i)
+        threads.push_back(std::thread(decode));
+    }
+    catch (...) {
+      STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCTables: can not create some threads\n"));
+    }
+    decode();
+    for (auto &thread : threads)
+      thread.join();
+    if (cancelled) {
+      m_spreadsheetState->m_tableRecordList.clear();
+      throw libstoff::ParseException();
+    }
+    ok=allOk;
+  }
+  m_spreadsheetState->m_tableRecordList.clear();
+  return ok;
+}
+
+bool StarObjectSpreadsheet::readSCTable(StarObjectSpreadsheetInternal::TableRecord const &record, STOFFInputStreamPtr input, std::string const &name)
+try
+{
+  if (!input || !record.m_table) return false;
+  StarZone zone(input, name, "SCTable", getPassword());
+  zone.setEncoding(record.m_encoding);
+  zone.setGuiType(record.m_guiType);
+  // the bytes before the table are already counted by the main zone
+  zone.setParseControlPosition(record.m_position);
+  input->seek(record.m_position, librevenge::RVNG_SEEK_SET);
+  return readSCTable(zone, *record.m_table);
+}
+catch (...)
+{
+  auto parseControl=input ? input->getParseControl() : std::shared_ptr<STOFFParseControl>();
+  if (parseControl && parseControl->isCancelled())
+    throw libstoff::ParseException();
+  STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCTable: can not decode a table\n"));
+  return false;
+}
+
 bool StarObjectSpreadsheet::readSCTable(StarZone &zone, StarObjectSpreadsheetInternal::Table &table)
 {
   STOFFInputStreamPtr input=zone.input();
@@ -1838,7 +2244,9 @@ bool StarObjectSpreadsheet::readSCTable(StarZone &zone, StarObjectSpreadsheetInt
           ascFile.addNote("SCTable-C###");
           break;
         }
-        if (!readSCColumn(zone,table, nCol, scRecord.getContentLastPosition())) {
+        if (!table.readColumn(nCol))
+          input->seek(scRecord.getContentLastPosition(), librevenge::RVNG_SEEK_SET);
+        else if (!readSCColumn(zone,table, nCol, scRecord.getContentLastPosition())) {
           ascFile.addPos(pos);
           ascFile.addNote("SCTable-C###");
           input->seek(scRecord.getContentLastPosition(), librevenge::RVNG_SEEK_SET);
@@ -1857,6 +2265,14 @@ bool StarObjectSpreadsheet::readSCTable(StarZone &zone, StarObjectSpreadsheetInt
       break;
     }
     long endDataPos=zone.getRecordLastPosition();
+    if (table.m_readOnlyOptions && id!=0x4242) {
+      f << "skipped,";
+      input->seek(endDataPos, librevenge::RVNG_SEEK_SET);
+      ascFile.addPos(pos);
+      ascFile.addNote(f.str().c_str());
+      zone.closeSCRecord("SCTable");
+      continue;
+    }
     switch (id) {
     case 0x4241: { // SCID_COLROWFLAGS
       f << "dim,";
@@ -1948,8 +2364,8 @@ bool StarObjectSpreadsheet::readSCTable(StarZone &zone, StarObjectSpreadsheetInt
         if (!string.empty()) {
           static char const* const wh[]= {"name", "comment", "pass"};
           f << wh[i] << "=" << libstoff::getString(string).cstr() << ",";
-          if (i==0 && !m_spreadsheetState->m_tableList.empty() && m_spreadsheetState->m_tableList.back())
-            m_spreadsheetState->m_tableList.back()->m_name=libstoff::getString(string);
+          if (i==0)
+            table.m_name=libstoff::getString(string);
         }
         if (i==2) break;
         *input>>bVal;
@@ -2105,11 +2521,21 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
     switch (id) {
     case 0x4251: {
       f << "notes,";
+      if (!table.readColumnData(column)) {
+        f << "skipped,";
+        input->seek(endDataPos, librevenge::RVNG_SEEK_SET);
+        break;
+      }
       uint16_t nCount;
       *input >> nCount;
       f << "n=" << nCount << ",";
       for (int i=0; i<nCount; ++i) {
         auto row=int(input->readULong(2));
+        if (row>table.getLastReadRow()) {
+          // the notes are sorted by row, the following notes are not needed
+          input->seek(endDataPos, librevenge::RVNG_SEEK_SET);
+          break;
+        }
         f << "note" << i << "[R" << row << ",";
         auto &cell=table.getCell(STOFFVec2i(column, row));
         // sc_cell.cxx ScBaseCell::LoadNotes, ScPostIt operator>>
@@ -2137,10 +2563,15 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
       uint16_t nCount;
       *input >> nCount;
       f << "n=" << nCount << ",";
-      std::shared_ptr<StarItemPool> pool=findItemPool(StarItemPool::T_SpreadsheetPool, false);
-      if (!pool) {
-        STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCColumn:can not read the spreadsheet pool, create a new one\n"));
-        pool=getNewItemPool(StarItemPool::T_SpreadsheetPool);
+      // the pool is shared by all the tables, so lock it only when it is accessed
+      std::shared_ptr<StarItemPool> pool;
+      {
+        std::lock_guard<std::mutex> lock(m_spreadsheetState->m_sharedDataMutex);
+        pool=findItemPool(StarItemPool::T_SpreadsheetPool, false);
+        if (!pool) {
+          STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCColumn:can not read the spreadsheet pool, create a new one\n"));
+          pool=getNewItemPool(StarItemPool::T_SpreadsheetPool);
+        }
       }
       f << "attrib=[";
 #if 0
@@ -2150,7 +2581,11 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
         auto newRow=int(input->readULong(2));
         f << newRow << ":";
         uint16_t nWhich=149;//StarAttribute::ATTR_SC_PATTERN-3;
-        auto item=pool->loadSurrogate(zone, nWhich, false, f);
+        std::shared_ptr<StarItem> item;
+        {
+          std::lock_guard<std::mutex> lock(m_spreadsheetState->m_sharedDataMutex);
+          item=pool->loadSurrogate(zone, nWhich, false, f);
+        }
         if (!item || input->tell()>endDataPos) {
           STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCColumn:can not read a attrib\n"));
           f << "###attrib";
@@ -2167,12 +2602,7 @@ bool StarObjectSpreadsheet::readSCColumn(StarZone &zone, StarObjectSpreadsheetIn
         std::cerr << "\tC" << column << "x" << STOFFVec2i(row, newRow) << ":" << f2.str().c_str() << "[" << item->m_attribute.get() << "]\n";
 #endif
         if (newRow>=row) {
-          table.updateRowsBlocks(STOFFVec2i(row, newRow));
-          auto it= table.m_rowToRowContentMap.lower_bound(STOFFVec2i(-1,row));
-          while (it!=table.m_rowToRowContentMap.end() && it->first[1]<=newRow) {
-            it->second.m_colToAttributeMap[STOFFVec2i(column, column)]=item->m_attribute;
-            ++it;
-          }
+          table.m_colToAttributeRunsMap[column][STOFFVec2i(row, newRow)]=item->m_attribute;
           row=newRow+1;
         }
       }
@@ -2206,6 +2636,14 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
   libstoff::DebugFile &ascFile=zone.ascii();
   libstoff::DebugStream f;
   f << "Entries(SCData)[C" << column << "-" << zone.getRecordLevel() << "]:" << scRecord;
+  if (!table.readColumnData(column)) {
+    f << "skipped,";
+    ascFile.addPos(pos);
+    ascFile.addNote(f.str().c_str());
+    input->seek(scRecord.getDataLastPosition(), librevenge::RVNG_SEEK_SET);
+    scRecord.close("SCData");
+    return true;
+  }
   auto count=int(input->readULong(2));
   f << "count=" << count << ",";
   ascFile.addPos(pos);
@@ -2225,6 +2663,11 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
       break;
     }
     auto row=int(input->readULong(2));
+    if (row>table.getLastReadRow()) {
+      // the cells are sorted by row, the following cells are not needed
+      input->seek(scRecord.getDataLastPosition(), librevenge::RVNG_SEEK_SET);
+      break;
+    }
     f << "row=" << row << ",";
     uint8_t what;
     *input>>what;
@@ -2322,7 +2765,8 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
         f.str("");
         f << "SCData[formula]:";
 
-        if (!StarCellFormula::readSCFormula(zone, cell.m_content, version, endDataPos) || input->tell()>endDataPos) {
+        if (!StarCellFormula::readSCFormula(zone, cell.m_content, version, endDataPos, STOFFVec2i(column, row), table.m_formulaCache) ||
+            input->tell()>endDataPos) {
           f << "###";
           scRecord.closeContent("SCData");
           ascFile.addDelimiter(input->tell(),'|');
@@ -2367,8 +2811,11 @@ bool StarObjectSpreadsheet::readSCData(StarZone &zone, StarObjectSpreadsheetInte
         *input>>unkn;
         if (unkn&0xf) input->seek((unkn&0xf), librevenge::RVNG_SEEK_CUR);
       }
+      std::unique_lock<std::mutex> lock(m_spreadsheetState->m_sharedDataMutex);
       std::shared_ptr<StarObjectSmallText> textZone(new StarObjectSmallText(*this, true));
-      if (!textZone->read(zone, lastPos) || input->tell()>lastPos) {
+      bool textOk=textZone->read(zone, lastPos);
+      lock.unlock();
+      if (!textOk || input->tell()>lastPos) {
         STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCData: can not open some edit text \n"));
         f << "###edit";
         ok=false;
@@ -2578,10 +3025,9 @@ bool StarObjectSpreadsheet::readSCChangeTrack(StarZone &zone, int /*version*/, l
     pos=input->tell();
     f.str("");
     f << "Entries(SCChangeTrack)[L]:###";
-    static bool first=true;
-    if (first) {
+    static std::atomic<bool> first(true);
+    if (first.exchange(false)) {
       STOFF_DEBUG_MSG(("StarObjectSpreadsheet::readSCChangeTrack: reading the action links is not implemented\n"));
-      first=false;
     }
     ascFile.addPos(pos);
     ascFile.addNote(f.str().c_str());
@@ -38,6 +38,8 @@
 #ifndef STAR_OBJECT_SPREADSHEET
 #  define STAR_OBJECT_SPREADSHEET
 
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "libstaroffice_internal.hxx"
@@ -49,6 +51,7 @@ class Cell;
 class Table;
 
 struct State;
+struct TableRecord;
 }
 
 class StarAttribute;
@@ -67,19 +70,34 @@ public:
   StarObjectSpreadsheet(StarObject const &orig, bool duplicateState);
   //! destructor
   ~StarObjectSpreadsheet() final;
+  /** sets the sheet and the window of cells which will be sent. Must be called before parse:
+      only the cells of the window of this sheet are decoded, see STOFFDocument::parse */
+  void setCellWindow(int sheet, STOFFBox2i const &window);
   //! try to parse the current object
   bool parse();
-  //! try to send the spreadsheet
-  bool send(STOFFSpreadsheetListenerPtr listener);
-  /** try to send a spreadsheet row.
+  /** try to send the spreadsheet. If sheet is positive, only sends the cells of this sheet
+      which are in window (and not the sheet's shapes) */
+  bool send(STOFFSpreadsheetListenerPtr listener, int sheet=-1, STOFFBox2i const &window=STOFFBox2i());
+  /** try to send a spreadsheet row; if columns is not empty, only sends the cells in columns.
 
    \note this function does not call openSheetRow,closeSheetRow */
-  bool sendRow(int table, int row, STOFFSpreadsheetListenerPtr listener);
-  /** try to send a cell */
-  bool sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener);
+  bool sendRow(int table, int row, STOFFSpreadsheetListenerPtr listener, STOFFVec2i const &columns=STOFFVec2i(0,-1));
+  /** try to send a cell, if span is not empty, it replaces the number of cells spanned by the cell */
+  bool sendCell(StarObjectSpreadsheetInternal::Cell &cell, StarAttribute *attrib, int table, int numRepeated, STOFFSpreadsheetListenerPtr listener,
+                STOFFVec2i const &span=STOFFVec2i(0,0));
   /** try to update the page span */
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages);
+  /** try to send the text cells, the notes and the shapes' text to a text extractor
+
+   \note the numeric and the formula cells are ignored */
+  void extractText(STOFFTextExtractorInterface &extractor) const;
 protected:
+  //! finds the merged cells which begin on the left of or above window and cover some of its cells: map clipped position -> (anchor, clipped span)
+  void findClippedMergedCells(StarObjectSpreadsheetInternal::Table const &sheet, STOFFBox2i const &window,
+                              std::map<STOFFVec2i, std::pair<STOFFVec2i, STOFFVec2i> > &posToAnchorSpanMap);
+  //! sends the part area of the merged cell which begins in anchor
+  bool sendMergedCell(int table, STOFFVec2i const &anchor, STOFFBox2i const &area, STOFFSpreadsheetListenerPtr listener);
+
   //
   // data
   //
@@ -88,6 +106,10 @@ protected:
   //! try to read a spreadshet style zone: SfxStyleSheets
   bool readSfxStyleSheets(STOFFInputStreamPtr input, std::string const &fileName);
 
+  //! try to decode the tables indexed by readCalcDocument, concurrently if possible
+  bool readSCTables(std::string const &name);
+  //! try to decode a table record using input
+  bool readSCTable(StarObjectSpreadsheetInternal::TableRecord const &record, STOFFInputStreamPtr input, std::string const &name);
   //! try to read a SCTable
   bool readSCTable(StarZone &zone, StarObjectSpreadsheetInternal::Table &table);
   //! try to read a SCColumn
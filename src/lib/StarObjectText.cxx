@@ -31,15 +31,20 @@
 * instead of those above.
 */
 
+#include <algorithm>
 #include <cstring>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <sstream>
+#include <utility>
 
 #include <librevenge/librevenge.h>
 
+#include <libstaroffice/libstaroffice.hxx>
+
 #include "STOFFList.hxx"
 #include "STOFFOLEParser.hxx"
 #include "STOFFPageSpan.hxx"
@@ -140,6 +145,14 @@ void Content::inventoryPages(StarState &state) const
   }
 }
 
+void Content::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  for (auto &z : m_zoneList) {
+    if (z)
+      z->extractText(extractor);
+  }
+}
+
 ////////////////////////////////////////
 //! Internal: a formatZone of StarObjectTextInteral
 struct FormatZone final : public Zone {
@@ -173,7 +186,7 @@ bool FormatZone::send(STOFFListenerPtr &listener, StarState &state) const
 //! Internal: a graphZone of StarObjectTextInteral
 struct GraphZone final : public Zone {
   //! constructor
-  explicit GraphZone(std::shared_ptr<STOFFOLEParser> &oleParser)
+  explicit GraphZone(std::shared_ptr<STOFFOLEParser> const &oleParser)
     : Zone()
     , m_oleParser(oleParser)
     , m_attributeList()
@@ -208,7 +221,7 @@ bool GraphZone::send(STOFFListenerPtr &listener, StarState &state) const
     return false;
   }
   STOFFGraphicStyle style=state.m_graphic;
-  state.m_frame.addTo(style.m_propertyList);
+  state.m_frame.get().addTo(style.m_propertyList);
   listener->insertPicture(state.m_frame, localPicture, style);
   return true;
 }
@@ -252,7 +265,7 @@ bool OLEZone::send(STOFFListenerPtr &listener, StarState &state) const
   std::shared_ptr<StarObject> localObj;
   auto dir=m_oleParser->getDirectory(m_name.cstr());
   STOFFGraphicStyle style=state.m_graphic;
-  state.m_frame.addTo(style.m_propertyList);
+  state.m_frame.get().addTo(style.m_propertyList);
   if (!dir || !StarFileManager::readOLEDirectory(m_oleParser, dir, localPicture, localObj) || localPicture.isEmpty()) {
     if (!localObj) {
       STOFF_DEBUG_MSG(("StarObjectTextInternal::OLEZone::send: sorry, can not find object %s\n", m_name.cstr()));
@@ -294,6 +307,12 @@ struct SectionZone final : public Zone {
   }
   //! try to send the data to a listener
   bool send(STOFFListenerPtr &listener, StarState &state) const final;
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const final
+  {
+    if (m_content)
+      m_content->extractText(extractor);
+  }
   //! the section name
   librevenge::RVNGString m_name;
   //! the section condition
@@ -325,6 +344,31 @@ bool SectionZone::send(STOFFListenerPtr &listener, StarState &state) const
   return true;
 }
 
+////////////////////////////////////////
+//! Internal: an event used to know when a character attribute begins/stops to be active
+struct AttributeEvent {
+  //! constructor
+  AttributeEvent(size_t position, bool add, size_t id)
+    : m_position(position)
+    , m_add(add)
+    , m_id(id)
+  {
+  }
+  //! operator<: sorts by position, then the additions before the removals
+  bool operator<(AttributeEvent const &ev) const
+  {
+    if (m_position!=ev.m_position) return m_position<ev.m_position;
+    if (m_add!=ev.m_add) return m_add;
+    return m_id<ev.m_id;
+  }
+  //! the position
+  size_t m_position;
+  //! a flag to know if the attribute is added or removed
+  bool m_add;
+  //! the attribute id
+  size_t m_id;
+};
+
 ////////////////////////////////////////
 //! Internal: a textZone of StarObjectTextInteral
 struct TextZone final : public Zone {
@@ -345,6 +389,12 @@ struct TextZone final : public Zone {
   void inventoryPage(StarState &state) const final;
   //! try to send the data to a listener
   bool send(STOFFListenerPtr &listener, StarState &state) const final;
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const final
+  {
+    libstoff::extractText(m_text, extractor);
+    extractor.insertBreak();
+  }
   //! the text
   std::vector<uint32_t> m_text;
   //! the text initial position
@@ -415,8 +465,8 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
       StarItemStyle const *style=state.m_global->m_pool->findStyleWithFamily(m_styleName, StarItemStyle::F_Paragraph);
       if (style) {
         if (style->m_outlineLevel>=0 && style->m_outlineLevel<20) {
-          state.m_paragraph.m_outline=true;
-          state.m_paragraph.m_listLevelIndex=style->m_outlineLevel+1;
+          state.m_paragraph.edit().m_outline=true;
+          state.m_paragraph.edit().m_listLevelIndex=style->m_outlineLevel+1;
         }
         for (auto it : style->m_itemSet.m_whichToItemMap) {
           if (it.second && it.second->m_attribute)
@@ -449,26 +499,57 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
   if (!state.m_refMark.empty()) {
     STOFF_DEBUG_MSG(("StarObjectTextInternal::TextZone::send: find a refMark in mainFont\n"));
   }
-  std::set<size_t> modPosSet;
-  modPosSet.insert(0);
-  for (auto const &attrib : m_charAttributeList) {
+  // the positions where the font changes and the attribute events
+  std::vector<size_t> modPosList(1,0);
+  std::vector<AttributeEvent> eventList;
+  for (size_t i=0; i<m_charAttributeList.size(); ++i) {
+    auto const &attrib=m_charAttributeList[i];
     if (attrib.m_position[0]>0)
-      modPosSet.insert(size_t(attrib.m_position[0]));
+      modPosList.push_back(size_t(attrib.m_position[0]));
     if (attrib.m_position[1]>0)
-      modPosSet.insert(size_t(attrib.m_position[1]));
-  }
-  std::multimap<size_t, std::shared_ptr<StarFormatManagerInternal::FormatDef> > posToFormat;
+      modPosList.push_back(size_t(attrib.m_position[1]));
+    if (!attrib.m_attribute)
+      continue;
+    size_t begin=attrib.m_position[0]>0 ? size_t(attrib.m_position[0]) : 0;
+    if (attrib.m_position[1]<0 && attrib.m_position[0]>=0) { // only active at its position
+      eventList.push_back(AttributeEvent(begin, true, i));
+      eventList.push_back(AttributeEvent(begin+1, false, i));
+      continue;
+    }
+    if (attrib.m_position[1]>=0 && size_t(attrib.m_position[1])<=begin)
+      continue;
+    eventList.push_back(AttributeEvent(begin, true, i));
+    if (attrib.m_position[1]>=0)
+      eventList.push_back(AttributeEvent(size_t(attrib.m_position[1]), false, i));
+  }
+  std::sort(modPosList.begin(), modPosList.end());
+  modPosList.erase(std::unique(modPosList.begin(), modPosList.end()), modPosList.end());
+  std::sort(eventList.begin(), eventList.end());
+  // either a paragraph anchor or a "at char" anchor
+  typedef std::pair<size_t, std::shared_ptr<StarFormatManagerInternal::FormatDef> > PosFormat;
+  std::vector<PosFormat> posToFormatList;
   for (auto const &c : m_formatList) {
     if (!c) continue;
-    // either a paragraph anchor or a "at char" anchor
-    StarState fState(state);
-    c->updateState(fState);
+    int anchorIndex=c->getAnchorIndex(state.m_global->m_pool);
     size_t lastIndex=m_textSourcePosition.empty() ? 0 : m_textSourcePosition.back();
-    size_t cPos=fState.m_frame.m_anchorIndex<0 ? 0 : fState.m_frame.m_anchorIndex>int(lastIndex) ? lastIndex :
-                size_t(fState.m_frame.m_anchorIndex);
-    posToFormat.insert(std::multimap<size_t, std::shared_ptr<StarFormatManagerInternal::FormatDef> >::value_type(cPos, c));
+    size_t cPos=anchorIndex<0 ? 0 : anchorIndex>int(lastIndex) ? lastIndex : size_t(anchorIndex);
+    posToFormatList.push_back(PosFormat(cPos, c));
   }
-  auto posSetIt=modPosSet.begin();
+  auto const posFormatLess=[](PosFormat const &a, PosFormat const &b)
+  {
+    return a.first<b.first;
+  };
+  std::stable_sort(posToFormatList.begin(), posToFormatList.end(), posFormatLess);
+  auto const findFormat=[&posToFormatList](size_t pos)
+  {
+    return std::lower_bound(posToFormatList.begin(), posToFormatList.end(), pos,
+    [](PosFormat const &a, size_t p) {
+      return a.first<p;
+    });
+  };
+  auto posSetIt=modPosList.begin();
+  auto eventIt=eventList.begin();
+  std::set<size_t> activeAttributeSet;
   int endLinkPos=-1, endRefMarkPos=-1;
   librevenge::RVNGString refMarkString;
   StarState lineState(state);
@@ -477,7 +558,7 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
   for (size_t c=0; c<= m_text.size(); ++c) {
     bool fontChange=false;
     size_t srcPos=c<m_textSourcePosition.size() ? m_textSourcePosition[c] : m_textSourcePosition.empty() ? 0 : 10000;
-    while (posSetIt!=modPosSet.end() && *posSetIt <= srcPos) {
+    while (posSetIt!=modPosList.end() && *posSetIt <= srcPos) {
       ++posSetIt;
       fontChange=true;
     }
@@ -489,16 +570,17 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
     bool softHyphen=false;
     bool hardBlank=false;
     if (fontChange) {
+      // update the list of active attributes
+      for (; eventIt!=eventList.end() && eventIt->m_position<=srcPos; ++eventIt) {
+        if (eventIt->m_add)
+          activeAttributeSet.insert(eventIt->m_id);
+        else
+          activeAttributeSet.erase(eventIt->m_id);
+      }
       lineState.reinitializeLineData();
       lineState.m_font=mainFont;
-      STOFFFont &font=lineState.m_font;
-      for (auto const &attrib : m_charAttributeList) {
-        if ((attrib.m_position[1]<0 && attrib.m_position[0]>=0 && attrib.m_position[0]!=int(srcPos)) ||
-            (attrib.m_position[0]>=0 && attrib.m_position[0]>int(srcPos)) ||
-            (attrib.m_position[1]>=0 && attrib.m_position[1]<=int(srcPos)))
-          continue;
-        if (!attrib.m_attribute)
-          continue;
+      for (auto id : activeAttributeSet) {
+        auto const &attrib=m_charAttributeList[id];
         attrib.m_attribute->addTo(lineState);
         if (!footnote && lineState.m_footnote)
           footnote=attrib.m_attribute;
@@ -552,6 +634,7 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
           lineState.m_refMark.clear();
         }
       }
+      STOFFFont const &font=lineState.m_font.get();
       softHyphen=font.m_softHyphen;
       hardBlank=font.m_hardBlank;
       listener->setFont(font);
@@ -559,20 +642,20 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
         int level=m_level;
         if (level==200) {
           level=state.m_global->m_listLevel;
-          lineState.m_paragraph.m_bulletVisible=true; // useMe
+          lineState.m_paragraph.edit().m_bulletVisible=true; // useMe
         }
-        if (!lineState.m_paragraph.m_outline) {
+        if (!lineState.m_paragraph.get().m_outline) {
           if (level>=0 && (!state.m_global->m_list || state.m_global->m_list->numLevels()<=int(level))) {
             STOFF_DEBUG_MSG(("StarObjectTextInternal::TextZone::send: oops can not find the list\n"));
             level=-1;
           }
           if (level>=0) {
-            lineState.m_paragraph.m_listLevel = state.m_global->m_list->getLevel(level);
-            lineState.m_paragraph.m_listId = state.m_global->m_list->getId();
-            lineState.m_paragraph.m_listLevelIndex = level+1;
+            lineState.m_paragraph.edit().m_listLevel = state.m_global->m_list->getLevel(level);
+            lineState.m_paragraph.edit().m_listId = state.m_global->m_list->getId();
+            lineState.m_paragraph.edit().m_listLevelIndex = level+1;
           }
           else
-            lineState.m_paragraph.m_listLevelIndex=0;
+            lineState.m_paragraph.edit().m_listLevelIndex=0;
         }
         listener->setParagraph(lineState.m_paragraph);
       }
@@ -584,7 +667,7 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
     }
     if (c==0 && !newPage && numPages && numPages!=lineState.m_global->m_pageNameList.size())
       listener->insertBreak(STOFFListener::SoftPageBreak);
-    for (auto it=posToFormat.lower_bound(srcPos); it!=posToFormat.upper_bound(srcPos); ++it) {
+    for (auto it=findFormat(srcPos); it!=posToFormatList.end() && it->first==srcPos; ++it) {
       StarState cState(*lineState.m_global);
       it->second->send(listener, cState);
     }
@@ -633,8 +716,21 @@ bool TextZone::send(STOFFListenerPtr &listener, StarState &state) const
       listener->insertTab();
     else if (m_text[c]==0xa)
       listener->insertEOL(true);
-    else
-      listener->insertUnicode(m_text[c]);
+    else {
+      // sends all the following characters which do not need a font change, a format, ...
+      size_t last=c+1;
+      while (last<m_text.size() && m_text[last]!=0x9 && m_text[last]!=0xa) {
+        size_t nextPos=last<m_textSourcePosition.size() ? m_textSourcePosition[last] : m_textSourcePosition.empty() ? 0 : 10000;
+        if ((posSetIt!=modPosList.end() && *posSetIt <= nextPos) || int(last)==endLinkPos || int(last)==endRefMarkPos)
+          break;
+        auto fIt=findFormat(nextPos);
+        if (fIt!=posToFormatList.end() && fIt->first==nextPos)
+          break;
+        ++last;
+      }
+      listener->insertUnicodeRun(&m_text[c], last-c);
+      c=last-1;
+    }
   }
   if (endLinkPos>=0) // check that not link is opened
     listener->closeLink();
@@ -657,6 +753,12 @@ struct Table final : public Zone {
   }
   //! try to send the data to a listener
   bool send(STOFFListenerPtr &listener, StarState &state) const final;
+  //! try to send the cells' text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const final
+  {
+    if (m_table)
+      m_table->extractText(extractor);
+  }
   //! the table
   std::shared_ptr<StarTable> m_table;
 };
@@ -688,7 +790,7 @@ bool Content::send(STOFFListenerPtr &listener, StarState &state, bool isFlyer) c
       StarState cState(state.m_global);
       auto subDoc = std::make_shared<SubDocument>(*this, cState);
       STOFFGraphicStyle style=cState.m_graphic;
-      state.m_frame.addTo(style.m_propertyList);
+      state.m_frame.get().addTo(style.m_propertyList);
       listener->insertTextBox(state.m_frame, subDoc, style);
       return true;
     }
@@ -813,6 +915,14 @@ bool StarObjectText::sendPages(STOFFTextListenerPtr &listener)
   return true;
 }
 
+void StarObjectText::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  if (m_textState->m_mainContent)
+    m_textState->m_mainContent->extractText(extractor);
+  if (m_textState->m_model)
+    m_textState->m_model->extractText(extractor);
+}
+
 ////////////////////////////////////////////////////////////
 // the parser
 ////////////////////////////////////////////////////////////
@@ -829,6 +939,10 @@ bool StarObjectText::parse()
   StarFileManager fileManager;
   STOFFInputStreamPtr mainOle; // let store the StarWriterDocument to read it in last position
   std::string mainName;
+  /* the numeric rulers only depend on their own stream, so they are read
+     concurrently with the other zones, which share the pools and the
+     format manager, and must be read one after the other */
+  std::vector<std::pair<std::shared_ptr<StarObjectNumericRuler>, std::future<bool> > > numericRulerTasks;
   for (auto const &name : unparsedOLEs) {
     STOFFInputStreamPtr ole = input->getSubStreamByName(name.c_str());
     if (!ole.get()) {
@@ -844,13 +958,25 @@ bool StarObjectText::parse()
       base = name.substr(pos+1);
     ole->setReadInverted(true);
     if (base=="SwNumRules") {
+      // the ruler must be created here, as it copies the object's state
+      std::shared_ptr<StarObjectNumericRuler> numericRuler(new StarObjectNumericRuler(*this,true));
+      char const *password=getPassword();
+      auto task=[numericRuler, ole, name, password]() {
+        try {
+          StarZone zone(ole, name, "StarNumericList", password);
+          return numericRuler->read(zone);
+        }
+        catch (...) {
+        }
+        return false;
+      };
       try {
-        StarZone zone(ole, name, "StarNumericList", getPassword());
-        std::shared_ptr<StarObjectNumericRuler> numericRuler(new StarObjectNumericRuler(*this,true));
-        if (numericRuler->read(zone))
-          m_textState->m_numericRuler=numericRuler;
+        numericRulerTasks.push_back(std::make_pair(numericRuler, std::async(std::launch::async, task)));
       }
       catch (...) {
+        // can not create a thread, read the ruler now
+        if (task())
+          m_textState->m_numericRuler=numericRuler;
       }
       continue;
     }
@@ -891,6 +1017,10 @@ bool StarObjectText::parse()
     asciiFile.addNote(f.str().c_str());
     asciiFile.reset();
   }
+  for (auto &task : numericRulerTasks) {
+    if (task.second.get())
+      m_textState->m_numericRuler=task.first;
+  }
   if (!mainOle) {
     STOFF_DEBUG_MSG(("StarObjectText::parser: can not find the main writer document\n"));
     return false;
@@ -1098,7 +1228,7 @@ bool StarObjectText::readSWGraphNode(StarZone &zone, std::shared_ptr<StarObjectT
   // sw_sw3nodes.cxx: InGrfNode
   libstoff::DebugStream f;
   f << "Entries(SWGraphNode)[" << zone.getRecordLevel() << "]:";
-  graphZone.reset(new StarObjectTextInternal::GraphZone(m_oleParser));
+  graphZone.reset(new StarObjectTextInternal::GraphZone(getOLEParser()));
   std::vector<uint32_t> text;
   int fl=zone.openFlagZone();
   if (fl&0x10) f << "link,";
@@ -1180,7 +1310,7 @@ bool StarObjectText::readSWGraphNode(StarZone &zone, std::shared_ptr<StarObjectT
           for (int p=0; p<numPoints; ++p) {
             int dim[2];
             for (int &j : dim) j=int(input->readLong(4));
-            graphZone->m_contour.m_points.push_back(StarGraphicStruct::StarPolygon::Point(STOFFVec2i(dim[0],dim[1])));
+            graphZone->m_contour.addPoint(STOFFVec2i(dim[0],dim[1]));
             f << STOFFVec2i(dim[0],dim[1]) << ",";
           }
           f << "],";
@@ -1338,10 +1468,12 @@ bool StarObjectText::readSWOLENode(StarZone &zone, std::shared_ptr<StarObjectTex
     return true;
   }
   ole.reset(new StarObjectTextInternal::OLEZone);
-  ole->m_oleParser=m_oleParser;
+  ole->m_oleParser=getOLEParser();
   if (!text.empty()) {
     ole->m_name=libstoff::getString(text);
     f << "objName=" << ole->m_name.cstr() << ",";
+    auto dir=ole->m_oleParser ? ole->m_oleParser->getDirectory(ole->m_name.cstr()) : std::shared_ptr<STOFFOLEParser::OleDirectory>();
+    if (dir) dir->m_referenced=true;
   }
   if (zone.isCompatibleWith(0x101)) {
     if (!zone.readString(text)) {
@@ -61,6 +61,10 @@ struct Zone {
   virtual void inventoryPage(StarState &/*state*/) const
   {
   }
+  //! try to send the text to a text extractor
+  virtual void extractText(STOFFTextExtractorInterface &/*extractor*/) const
+  {
+  }
 };
 
 //! Internal: a set of zone
@@ -77,6 +81,8 @@ struct Content {
   bool send(STOFFListenerPtr &listener, StarState &state, bool isFlyer=false) const;
   //! try to inventory the different pages
   void inventoryPages(StarState &state) const;
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
   //! the section name
   librevenge::RVNGString m_sectionName;
   //! the list of text zone
@@ -112,6 +118,8 @@ public:
   bool updatePageSpans(std::vector<STOFFPageSpan> &pageSpan, int &numPages);
   //! try to send the different page
   bool sendPages(STOFFTextListenerPtr &listener);
+  //! try to send the main text and the drawing layer's text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
 
   //! try to read a image map zone : 'X'
   static bool readSWImageMap(StarZone &zone);
@@ -38,6 +38,7 @@
 #ifndef STAR_STATE_HXX
 #  define STAR_STATE_HXX
 
+#include <memory>
 #include <vector>
 
 #include "libstaroffice_internal.hxx"
@@ -62,7 +63,85 @@ namespace SWFieldManagerInternal
 struct Field;
 }
 
+/** \brief a copy-on-write holder used to store the components of a StarState
+
+    The copies of a StarState share their components, a component is only
+    duplicated when it is modified by a state, ie. when edit is called
+    while it is shared: the other accessors are read-only. The default components share the same
+    default value.
+
+    \note do not keep a non const reference on a component while the state is
+    copied, the reference would then be shared by the two states.
+ */
+template<class T> class StarStateComponent
+{
+public:
+  //! constructor: uses the default value
+  StarStateComponent()
+    : m_data(getDefault())
+  {
+  }
+  //! constructor from a value
+  explicit StarStateComponent(T const &data)
+    : m_data(std::make_shared<T>(data))
+  {
+  }
+  //! sets the value
+  StarStateComponent &operator=(T const &data)
+  {
+    if (m_data.use_count()==1)
+      *m_data=data;
+    else
+      m_data=std::make_shared<T>(data);
+    return *this;
+  }
+  //! resets the value to the default value
+  void reset()
+  {
+    m_data=getDefault();
+  }
+  //! returns the value
+  T const &get() const
+  {
+    return *m_data;
+  }
+  //! returns the value, duplicates it if it is shared
+  T &edit()
+  {
+    if (m_data.use_count()>1)
+      m_data=std::make_shared<T>(*m_data);
+    return *m_data;
+  }
+  //! returns the value
+  operator T const &() const
+  {
+    return *m_data;
+  }
+  //! returns the value
+  T const &operator*() const
+  {
+    return *m_data;
+  }
+  //! returns a pointer to the value
+  T const *operator->() const
+  {
+    return m_data.get();
+  }
+protected:
+  //! returns the shared default value
+  static std::shared_ptr<T> const &getDefault()
+  {
+    static std::shared_ptr<T> const s_default=std::make_shared<T>();
+    return s_default;
+  }
+  //! the data
+  std::shared_ptr<T> m_data;
+};
+
 /** \brief class to store an state: ie. the current page, section, ... style
+
+    \note the cell, frame, graphic, paragraph and font styles are stored in
+    StarStateComponent, so copying a state is cheap.
  */
 class StarState
 {
@@ -170,16 +249,16 @@ public:
   int m_break;
 
   /// the cell style
-  STOFFCellStyle m_cell;
+  StarStateComponent<STOFFCellStyle> m_cell;
   /// the frame style
-  STOFFFrameStyle m_frame;
+  StarStateComponent<STOFFFrameStyle> m_frame;
   /// the graphic style
-  STOFFGraphicStyle m_graphic;
+  StarStateComponent<STOFFGraphicStyle> m_graphic;
 
   /// the paragraph style
-  STOFFParagraph m_paragraph;
+  StarStateComponent<STOFFParagraph> m_paragraph;
   /// the font
-  STOFFFont m_font;
+  StarStateComponent<STOFFFont> m_font;
   /// flag to know if this is a content zone
   bool m_content;
   /// flag to know if this is a flyCnt
@@ -76,6 +76,8 @@ struct TableBox {
   bool read(Table &table, StarZone &zone, StarObjectText &object, STOFFBox2i &cPos);
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const;
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
   //! update the position to correspond to cover the m_position[0],right/bottom
   void updatePosition(Table &table, StarState const &state, float xOrigin, STOFFVec2i const &RBpos=STOFFVec2i(-1,-1));
   //! the position
@@ -109,6 +111,8 @@ struct TableLine {
   }
   //! try to read the data
   bool read(Table &table, StarZone &zone, StarObjectText &object, STOFFBox2i &cPos);
+  //! try to send the text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
   //! update the position to correspond to cover the m_position[0],right/bottom
   void updatePosition(Table &table, StarState const &state, float xOrigin, STOFFVec2i const &RBpos=STOFFVec2i(-1,-1));
   //! the position
@@ -174,6 +178,24 @@ public:
   std::map<int, std::vector<StarTableInternal::TableBox *> > m_rowToBoxMap;
 };
 
+void TableBox::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  if (m_content)
+    m_content->extractText(extractor);
+  for (auto const &line : m_lineList) {
+    if (line)
+      line->extractText(extractor);
+  }
+}
+
+void TableLine::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  for (auto const &box : m_boxList) {
+    if (box)
+      box->extractText(extractor);
+  }
+}
+
 void TableBox::updatePosition(Table &table, StarState const &state, float xOrigin, STOFFVec2i const &RBpos)
 {
   for (int i=0; i<2; ++i) {
@@ -189,9 +211,9 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
     }
   }
   if (m_format) {
-    cState.m_frame.m_position.m_size=STOFFVec2i(0,0);
+    cState.m_frame.edit().m_position.m_size=STOFFVec2i(0,0);
     m_format->updateState(cState);
-    if (cState.m_frame.m_position.m_size[0]<=0) {
+    if (cState.m_frame.get().m_position.m_size[0]<=0) {
       if (m_lineList.empty()) {
         static bool first=true;
         if (first) {
@@ -202,10 +224,10 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
       }
     }
     else {
-      m_xDimension=STOFFVec2f(xOrigin, xOrigin+cState.m_frame.m_position.m_size[0]);
-      table.m_xPositionSet.insert(xOrigin+cState.m_frame.m_position.m_size[0]);
-      if (cState.m_frame.m_position.m_size[0] < table.m_minColWidth)
-        table.m_minColWidth=cState.m_frame.m_position.m_size[0];
+      m_xDimension=STOFFVec2f(xOrigin, xOrigin+cState.m_frame.get().m_position.m_size[0]);
+      table.m_xPositionSet.insert(xOrigin+cState.m_frame.get().m_position.m_size[0]);
+      if (cState.m_frame.get().m_position.m_size[0] < table.m_minColWidth)
+        table.m_minColWidth=cState.m_frame.get().m_position.m_size[0];
     }
   }
   else if (m_lineList.empty()) {
@@ -222,7 +244,7 @@ void TableBox::updatePosition(Table &table, StarState const &state, float xOrigi
       table.m_rowToBoxMap[row]=std::vector<StarTableInternal::TableBox *>();
     table.m_rowToBoxMap.find(row)->second.push_back(this);
     m_cellStyle=cState.m_cell;
-    cState.m_frame.addTo(m_cellStyle.m_propertyList);
+    cState.m_frame.get().addTo(m_cellStyle.m_propertyList);
     return;
   }
   for (size_t i=0; i< m_lineList.size(); ++i) {
@@ -588,17 +610,17 @@ bool StarTableInternal::Table::send(STOFFListenerPtr listener, StarState &state)
   STOFFTable table;
   if (m_format) {
     m_format->updateState(cState);
-    table.m_propertyList=cState.m_cell.m_propertyList;
-    cState.m_frame.addTo(table.m_propertyList);
+    table.m_propertyList=cState.m_cell.get().m_propertyList;
+    cState.m_frame.get().addTo(table.m_propertyList);
 
-    m_minColWidth=cState.m_frame.m_position.m_size[0];
+    m_minColWidth=cState.m_frame.get().m_position.m_size[0];
     // checkme sometime the width is 65535/20, ie. bigger than the page width...
-    if (cState.m_frame.m_position.m_size[0]>=float(int(65535/20))) {
-      percentMaxValue=cState.m_frame.m_position.m_size[0];
+    if (cState.m_frame.get().m_position.m_size[0]>=float(int(65535/20))) {
+      percentMaxValue=cState.m_frame.get().m_position.m_size[0];
       table.m_propertyList.insert("style:width", 1., librevenge::RVNG_PERCENT);
     }
-    else if (cState.m_frame.m_position.m_size[0]>0)
-      table.m_propertyList.insert("style:width", double(cState.m_frame.m_position.m_size[0]), librevenge::RVNG_POINT);
+    else if (cState.m_frame.get().m_position.m_size[0]>0)
+      table.m_propertyList.insert("style:width", double(cState.m_frame.get().m_position.m_size[0]), librevenge::RVNG_POINT);
   }
   m_xPositionSet.insert(0);
   for (auto line : m_lineList) {
@@ -677,4 +699,12 @@ bool StarTable::send(STOFFListenerPtr listener, StarState &state) const
   return m_table->send(listener, state);
 }
 
+void StarTable::extractText(STOFFTextExtractorInterface &extractor) const
+{
+  for (auto const &line : m_table->m_lineList) {
+    if (line)
+      line->extractText(extractor);
+  }
+}
+
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
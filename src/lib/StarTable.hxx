@@ -65,6 +65,8 @@ public:
   bool read(StarZone &zone, StarObjectText &object);
   //! try to send the data to a listener
   bool send(STOFFListenerPtr listener, StarState &state) const;
+  //! try to send the cells' text to a text extractor
+  void extractText(STOFFTextExtractorInterface &extractor) const;
 
   //! the table
   std::shared_ptr<StarTableInternal::Table> m_table;
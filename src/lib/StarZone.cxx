@@ -39,6 +39,8 @@
 
 #include <librevenge/librevenge.h>
 
+#include "STOFFParseControl.hxx"
+
 #include "StarEncryption.hxx"
 
 #include "StarZone.hxx"
@@ -62,11 +64,36 @@ StarZone::StarZone(STOFFInputStreamPtr const &inputStream, std::string const &as
   , m_beginToEndMap()
   , m_flagEndZone()
   , m_poolList()
+  , m_parseControl(inputStream ? inputStream->getParseControl() : std::shared_ptr<STOFFParseControl>())
+  , m_parseControlPosition(0)
 {
   if (password)
     m_encryption.reset(new StarEncryption(password));
 }
 
+StarZone::StarZone(StarZone const &orig, long endPos)
+  : m_input(orig.m_input)
+  , m_ascii(orig.m_input)
+  , m_version(orig.m_version)
+  , m_documentVersion(orig.m_documentVersion)
+  , m_headerVersionStack()
+  , m_encoding(orig.m_encoding)
+  , m_guiType(orig.m_guiType)
+  , m_encryption(orig.m_encryption)
+  , m_asciiName("")
+  , m_zoneName(orig.m_zoneName)
+  , m_typeStack()
+  , m_positionStack()
+  , m_beginToEndMap()
+  , m_flagEndZone()
+  , m_poolList(orig.m_poolList)
+  , m_parseControl(orig.m_parseControl)
+  , m_parseControlPosition(endPos) // the bytes are already counted by orig
+{
+  m_typeStack.push('_');
+  m_positionStack.push(endPos);
+}
+
 StarZone::~StarZone()
 {
   m_ascii.reset();
@@ -76,6 +103,8 @@ void StarZone::setInput(STOFFInputStreamPtr ip)
 {
   m_input=ip;
   m_ascii.setStream(ip);
+  if (ip && ip->getParseControl())
+    m_parseControl=ip->getParseControl();
 }
 
 bool StarZone::readString(std::vector<uint32_t> &string, std::vector<size_t> &srcPositions, int encoding, bool chckEncryption) const
@@ -341,6 +370,7 @@ bool StarZone::readSWHeader()
 bool StarZone::openSCHHeader()
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+6)) return false;
   // schiocmp.cxx: SchIOHeader::SchIOHeader
   auto len=long(m_input->readULong(4));
@@ -363,7 +393,7 @@ bool StarZone::openSCHHeader()
   return true;
 }
 
-bool StarZone::closeSCHHeader(std::string const &debugName)
+bool StarZone::closeSCHHeader(char const *debugName)
 {
   if (!m_headerVersionStack.empty()) m_headerVersionStack.pop();
   return closeRecord('@', debugName);
@@ -372,6 +402,7 @@ bool StarZone::closeSCHHeader(std::string const &debugName)
 bool StarZone::openVersionCompatHeader()
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+6)) return false;
   // vcompat.cxx: VersionCompat::VersionCompat
   m_headerVersionStack.push(int(m_input->readULong(2)));
@@ -394,7 +425,7 @@ bool StarZone::openVersionCompatHeader()
   return true;
 }
 
-bool StarZone::closeVersionCompatHeader(std::string const &debugName)
+bool StarZone::closeVersionCompatHeader(char const *debugName)
 {
   if (!m_headerVersionStack.empty()) m_headerVersionStack.pop();
   return closeRecord('*', debugName);
@@ -403,6 +434,7 @@ bool StarZone::closeVersionCompatHeader(std::string const &debugName)
 bool StarZone::openSDRHeader(std::string &magic)
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+4)) return false;
   // svdio.cxx: SdrIOHeader::Read
   magic="";
@@ -433,7 +465,7 @@ bool StarZone::openSDRHeader(std::string &magic)
   return true;
 }
 
-bool StarZone::closeSDRHeader(std::string const &debugName)
+bool StarZone::closeSDRHeader(char const *debugName)
 {
   if (!m_headerVersionStack.empty()) m_headerVersionStack.pop();
   return closeRecord('_', debugName);
@@ -455,6 +487,7 @@ bool StarZone::openDummyRecord()
 bool StarZone::openRecord()
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long sz=m_input->readULong(4);
   long endPos=0;
@@ -483,6 +516,7 @@ bool StarZone::openRecord()
 bool StarZone::openSCRecord()
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long sz=m_input->readULong(4);
   long endPos=0;
@@ -507,6 +541,7 @@ bool StarZone::openSCRecord()
 bool StarZone::openSWRecord(unsigned char &type)
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+4)) return false;
   unsigned long val=m_input->readULong(4);
   type=static_cast<unsigned char>(val&0xff);
@@ -550,6 +585,7 @@ bool StarZone::openSWRecord(unsigned char &type)
 bool StarZone::openSfxRecord(unsigned char &type)
 {
   long pos=m_input->tell();
+  checkParseControl(pos);
   if (!m_input->checkPosition(pos+4)) return false;
   // filerec.cxx SfxMiniRecordReader::SfxMiniRecordReader
   unsigned long val=m_input->readULong(4);
@@ -575,7 +611,7 @@ bool StarZone::openSfxRecord(unsigned char &type)
   return true;
 }
 
-bool StarZone::closeRecord(unsigned char type, std::string const &debugName)
+bool StarZone::closeRecord(unsigned char type, char const *debugName)
 {
   m_flagEndZone=0;
   while (!m_typeStack.empty()) {
@@ -634,6 +670,19 @@ void StarZone::closeFlagZone()
   m_input->seek(m_flagEndZone, librevenge::RVNG_SEEK_SET);
 }
 
+void StarZone::checkParseControl(long pos)
+{
+  if (!m_parseControl) return;
+  if (pos>m_parseControlPosition) {
+    m_parseControl->addNumBytesRead(pos-m_parseControlPosition);
+    m_parseControlPosition=pos;
+  }
+  if (m_parseControl->isCancelled()) {
+    STOFF_DEBUG_MSG(("StarZone::checkParseControl: the parsing is cancelled\n"));
+    throw libstoff::ParseException();
+  }
+}
+
 bool StarZone::readRecordSizes(long pos)
 {
   if (!pos || !isCompatibleWith('%'))
@@ -667,7 +716,7 @@ bool StarZone::readRecordSizes(long pos)
 
     m_ascii.addPos(pos);
     m_ascii.addNote(f.str().c_str());
-    closeSWRecord('%',m_zoneName);
+    closeSWRecord('%',m_zoneName.c_str());
     if (oldPos!=pos)
       m_input->seek(oldPos, librevenge::RVNG_SEEK_SET);
     return true;
@@ -681,7 +730,7 @@ bool StarZone::readRecordSizes(long pos)
   }
   f << "],";
 
-  closeSWRecord('%',m_zoneName);
+  closeSWRecord('%',m_zoneName.c_str());
   if (oldPos!=pos)
     m_input->seek(oldPos, librevenge::RVNG_SEEK_SET);
 
@@ -46,6 +46,7 @@
 #include "STOFFDebug.hxx"
 #include "StarEncoding.hxx"
 
+class STOFFParseControl;
 class StarEncryption;
 
 /** \brief a zone in a StarOffice file
@@ -58,6 +59,9 @@ class StarZone
 public:
   //! constructor
   StarZone(STOFFInputStreamPtr const &input, std::string const &ascName, std::string const &zoneName, char const *password);
+  /** constructor used to read again a part of orig's input: the zone
+      shares orig's input, versions, encoding and encryption and stops at endPos */
+  StarZone(StarZone const &orig, long endPos);
   //! destructor
   virtual ~StarZone();
   //! read the zone header present in a SW file
@@ -68,17 +72,17 @@ public:
   //! open a zone header present in a SDR file
   bool openSDRHeader(std::string &magic);
   //! close a zone header
-  bool closeSDRHeader(std::string const &debugName);
+  bool closeSDRHeader(char const *debugName);
 
   //! open a zone header present in a SCH file
   bool openSCHHeader();
   //! close a zone header
-  bool closeSCHHeader(std::string const &debugName);
+  bool closeSCHHeader(char const *debugName);
 
   //! open a version compat header (version+size)
   bool openVersionCompatHeader();
   //! close a zone header
-  bool closeVersionCompatHeader(std::string const &debugName);
+  bool closeVersionCompatHeader(char const *debugName);
 
   //! returns the StarOffice version: 3-5
   int getVersion() const
@@ -137,6 +141,12 @@ public:
   {
     m_guiType=type;
   }
+  /** sets the position from which the bytes read are counted by the parse control,
+      ie. the bytes before pos are supposed already counted */
+  void setParseControlPosition(long pos)
+  {
+    m_parseControlPosition=pos;
+  }
   //
   // basic
   //
@@ -144,7 +154,7 @@ public:
   //! try to open a classic record: size (32 bytes) +  size-4 bytes
   bool openRecord();
   //! try to close a record
-  bool closeRecord(std::string const &debugName)
+  bool closeRecord(char const *debugName)
   {
     return closeRecord(' ', debugName);
   }
@@ -162,7 +172,7 @@ public:
   //! try to open a SC record: size (32 bytes) + size bytes
   bool openSCRecord();
   //! try to close a record
-  bool closeSCRecord(std::string const &debugName)
+  bool closeSCRecord(char const *debugName)
   {
     return closeRecord('_', debugName);
   }
@@ -174,7 +184,7 @@ public:
   //! try to open a SW record: type + size (24 bytes)
   bool openSWRecord(unsigned char &type);
   //! try to close a record
-  bool closeSWRecord(unsigned char type, std::string const &debugName)
+  bool closeSWRecord(unsigned char type, char const *debugName)
   {
     return closeRecord(type, debugName);
   }
@@ -186,7 +196,7 @@ public:
   //! try to open a Sfx record: type + size (24 bytes)
   bool openSfxRecord(unsigned char &type);
   //! try to close a record
-  bool closeSfxRecord(unsigned char type, std::string const &debugName)
+  bool closeSfxRecord(unsigned char type, char const *debugName)
   {
     return closeRecord(type, debugName);
   }
@@ -268,7 +278,11 @@ protected:
   //! try to read the record sizes
   bool readRecordSizes(long pos);
   //! try to close a record
-  bool closeRecord(unsigned char type, std::string const &debugName);
+  bool closeRecord(unsigned char type, char const *debugName);
+  /** updates the number of bytes read (if a parse control exists)
+
+   \note throws a libstoff::ParseException if the parsing is cancelled */
+  void checkParseControl(long pos);
 
   //
   // data
@@ -306,6 +320,11 @@ protected:
 
   //! the pool name list
   std::vector<librevenge::RVNGString> m_poolList;
+
+  //! the object used to follow/cancel the parsing (if any)
+  std::shared_ptr<STOFFParseControl> m_parseControl;
+  //! the last position sent to the parse control
+  long m_parseControlPosition;
 };
 #endif
 // vim: set filetype=cpp tabstop=2 shiftwidth=2 cindent autoindent smartindent noexpandtab:
@@ -40,10 +40,13 @@
 #include <time.h>
 
 #include <ctype.h>
+#include <string.h>
 #include <locale.h>
 
 #include <librevenge-stream/librevenge-stream.h>
 
+#include <libstaroffice/libstaroffice.hxx>
+
 #include "libstaroffice_internal.hxx"
 
 /** namespace used to regroup all libwpd functions, enumerations which we have redefined for internal usage */
@@ -78,13 +81,14 @@ librevenge::RVNGString getString(std::vector<uint32_t> const &unicode)
   return res;
 }
 
-void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
+//! encodes a unicode character in UTF-8, returns the number of bytes written in outbuf
+static int encodeUnicode(uint32_t val, char *outbuf)
 {
   uint8_t first;
   int len;
   if (val < 0x80) {
-    first = 0;
-    len = 1;
+    outbuf[0] = char(val);
+    return 1;
   }
   else if (val < 0x800) {
     first = 0xc0;
@@ -107,16 +111,96 @@ void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
     len = 6;
   }
 
-  char outbuf[7];
-  int i;
-  for (i = len - 1; i > 0; --i) {
+  for (int i = len - 1; i > 0; --i) {
     outbuf[i] = char((val & 0x3f) | 0x80);
     val >>= 6;
   }
   outbuf[0] = char(val | first);
-  outbuf[len] = 0;
+  return len;
+}
+
+void extractText(std::vector<uint32_t> const &unicode, STOFFTextExtractorInterface &extractor)
+{
+  if (unicode.empty()) return;
+  std::string res;
+  res.reserve(unicode.size()+10);
+  for (auto c : unicode) {
+    if (c==0x9 || c==0xa)
+      res+=' ';
+    else if (c<0x20 || (c>=0xd800 && c<0xe000) || c>0x10ffff)
+      continue;
+    else if (c<0x80)
+      res+=char(c);
+    else {
+      char outbuf[7];
+      res.append(outbuf, size_t(encodeUnicode(c, outbuf)));
+    }
+  }
+  if (!res.empty())
+    extractor.insertText(res.c_str(), static_cast<unsigned long>(res.size()));
+}
+
+void appendUnicode(uint32_t val, librevenge::RVNGString &buffer)
+{
+  char outbuf[7];
+  outbuf[encodeUnicode(val, outbuf)] = 0;
   buffer.append(outbuf);
 }
+
+bool appendUnicodeRun(uint32_t const *chars, size_t numChars, librevenge::RVNGString &buffer)
+{
+  if (!chars || !numChars) return false;
+  bool prevIsSpace=buffer.size()>0 && buffer.cstr()[buffer.size()-1]==' ';
+  bool hasConsecutiveSpaces=false;
+  std::string res;
+  res.reserve(numChars+16);
+  size_t c=0;
+  while (c<numChars) {
+    if (c+8<=numChars) {
+      // fast path: checks a block of 8 characters without branching, if they are all
+      // printable ASCII characters, copies them directly
+      bool isAscii=true;
+      for (size_t i=0; i<8; ++i)
+        isAscii &= (chars[c+i]-0x20u) < 0x60u;
+      if (isAscii) {
+        char block[8];
+        for (size_t i=0; i<8; ++i) {
+          block[i]=char(chars[c+i]);
+          bool isSpace=block[i]==' ';
+          hasConsecutiveSpaces |= isSpace && prevIsSpace;
+          prevIsSpace=isSpace;
+        }
+        res.append(block, 8);
+        c+=8;
+        continue;
+      }
+    }
+    uint32_t val=chars[c++];
+    // undef or odd character, we skip it
+    if (val==0xfffd || (val<0x20 && val!=0x9 && val!=0xa && val!=0xd))
+      continue;
+    bool isSpace=val==0x20;
+    hasConsecutiveSpaces |= isSpace && prevIsSpace;
+    prevIsSpace=isSpace;
+    if (val<0x80) {
+      res+=char(val);
+      continue;
+    }
+    char outbuf[7];
+    res.append(outbuf, size_t(encodeUnicode(val, outbuf)));
+  }
+  if (!res.empty())
+    buffer.append(res.c_str());
+  return hasConsecutiveSpaces;
+}
+
+bool createsConsecutiveSpaces(librevenge::RVNGString const &buffer, char const *text)
+{
+  if (!text || !*text) return false;
+  if (text[0]==' ' && buffer.size()>0 && buffer.cstr()[buffer.size()-1]==' ')
+    return true;
+  return strstr(text, "  ")!=nullptr;
+}
 }
 
 namespace libstoff
@@ -316,6 +400,8 @@ bool STOFFEmbeddedObject::addTo(librevenge::RVNGPropertyList &propList) const
     if (!firstSet) {
       propList.insert("librevenge:mime-type", type.c_str());
       propList.insert("office:binary-data", m_dataList[i]);
+      if (i==0 && m_callList && !m_callList->empty())
+        propList.insert("librevenge:stoff-calls", *m_callList);
       firstSet=true;
       continue;
     }
@@ -153,14 +153,25 @@ class WrongPasswordException
 };
 }
 
+class STOFFTextExtractorInterface;
+
 /* ---------- input ----------------- */
 namespace libstoff
 {
 uint8_t readU8(librevenge::RVNGInputStream *input);
 //! adds an unicode character to a string
 void appendUnicode(uint32_t val, librevenge::RVNGString &buffer);
+/** adds a run of unicode characters to a string: the characters 0xfffd and the control
+    characters (excepted tab, LF and CR) are ignored. Returns true if the string then
+    contains two consecutive spaces which were not already in it */
+bool appendUnicodeRun(uint32_t const *chars, size_t numChars, librevenge::RVNGString &buffer);
+//! returns true if appending text to buffer creates two consecutive spaces
+bool createsConsecutiveSpaces(librevenge::RVNGString const &buffer, char const *text);
 //! transform a unicode string in a RNVGString
 librevenge::RVNGString getString(std::vector<uint32_t> const &unicode);
+/** sends a unicode string to a text extractor in UTF-8, the tabulations and
+    the line breaks are replaced by spaces, the other control characters are ignored */
+void extractText(std::vector<uint32_t> const &unicode, STOFFTextExtractorInterface &extractor);
 
 //! checks whether addition of \c x and \c y would overflow
 template<typename T>
@@ -407,12 +418,12 @@ struct STOFFNote {
  */
 struct STOFFEmbeddedObject {
   //! empty constructor
-  STOFFEmbeddedObject() : m_dataList(), m_typeList(),  m_filenameLink("")
+  STOFFEmbeddedObject() : m_dataList(), m_typeList(),  m_filenameLink(""), m_callList()
   {
   }
   //! constructor
   STOFFEmbeddedObject(librevenge::RVNGBinaryData const &binaryData,
-                      std::string const &type="image/pict") : m_dataList(), m_typeList(), m_filenameLink("")
+                      std::string const &type="image/pict") : m_dataList(), m_typeList(), m_filenameLink(""), m_callList()
   {
     add(binaryData, type);
   }
@@ -458,6 +469,8 @@ struct STOFFEmbeddedObject {
   std::vector<std::string> m_typeList;
   //! a picture link
   librevenge::RVNGString m_filenameLink;
+  //! the calls stored in the first data (if they are recorded), see STOFFPropertyHandler::replayCalls
+  std::shared_ptr<librevenge::RVNGPropertyListVector const> m_callList;
 };
 
 // forward declarations of basic classes and smart pointers